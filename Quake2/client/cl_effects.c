@@ -37,8 +37,6 @@ static vec3_t avelocities[NUMVERTEXNORMALS];
 extern struct model_s *cl_mod_smoke;
 extern struct model_s *cl_mod_flash;
 
-extern cparticle_t *active_particles, *free_particles;
-
 void
 CL_AddMuzzleFlash(void)
 {
@@ -786,16 +784,13 @@ CL_TeleporterParticles(entity_state_t *ent)
 
 	for (i = 0; i < 8; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = 0xdb;
 
@@ -827,16 +822,13 @@ CL_LogoutEffect(vec3_t org, int type)
 
 	for (i = 0; i < 500; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 
 		if (type == MZ_LOGIN)
@@ -882,16 +874,13 @@ CL_ItemRespawnParticles(vec3_t org)
 
 	for (i = 0; i < 64; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = 0xd4 + (randk() & 3);
 		p->org[0] = org[0] + crandk() * 8;
@@ -922,16 +911,13 @@ CL_ExplosionParticles(vec3_t org)
 
 	for (i = 0; i < 256; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = 0xe0 + (randk() & 7);
 
@@ -962,16 +948,13 @@ CL_BigTeleportParticles(vec3_t org)
 
 	for (i = 0; i < 4096; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = colortable[randk() & 3];
 
@@ -1012,16 +995,13 @@ CL_BlasterParticles(vec3_t org, vec3_t dir)
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = 0xe0 + (randk() & 7);
 		d = randk() & 15;
@@ -1064,15 +1044,12 @@ CL_BlasterTrail(vec3_t start, vec3_t end)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -1116,15 +1093,12 @@ CL_QuadTrail(vec3_t start, vec3_t end)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -1168,15 +1142,12 @@ CL_FlagTrail(vec3_t start, vec3_t end, int color)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -1238,18 +1209,16 @@ CL_DiminishingTrail(vec3_t start, vec3_t end, centity_t *old, int flags)
 	{
 		len -= dec;
 
-		if (!free_particles)
-		{
-			return;
-		}
-
 		/* drop less particles as it flies */
 		if ((randk() & 1023) < old->trailcount)
 		{
-			p = free_particles;
-			free_particles = p->next;
-			p->next = active_particles;
-			active_particles = p;
+			p = CL_AllocParticle();
+
+			if (!p)
+			{
+				return;
+			}
+
 			VectorClear(p->accel);
 
 			p->time = time;
@@ -1356,17 +1325,14 @@ CL_RocketTrail(vec3_t start, vec3_t end, centity_t *old)
 	{
 		len -= dec;
 
-		if (!free_particles)
-		{
-			return;
-		}
-
 		if ((randk() & 7) == 0)
 		{
-			p = free_particles;
-			free_particles = p->next;
-			p->next = active_particles;
-			active_particles = p;
+			p = CL_AllocParticle();
+
+			if (!p)
+			{
+				return;
+			}
 
 			VectorClear(p->accel);
 			p->time = time;
@@ -1414,16 +1380,13 @@ CL_RailTrail(vec3_t start, vec3_t end)
 
 	for (i = 0; i < len; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		VectorClear(p->accel);
 
@@ -1455,16 +1418,13 @@ CL_RailTrail(vec3_t start, vec3_t end)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		VectorClear(p->accel);
 
@@ -1508,15 +1468,12 @@ CL_IonripperTrail(vec3_t start, vec3_t ent)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -1570,16 +1527,13 @@ CL_BubbleTrail(vec3_t start, vec3_t end)
 
 	for (i = 0; i < len; i += 32)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		VectorClear(p->accel);
 		p->time = time;
 
@@ -1643,16 +1597,13 @@ CL_FlyParticles(vec3_t origin, int count)
 		forward[1] = cp * sy;
 		forward[2] = -sp;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 
 		dist = (float)sin(ltime + i) * 64;
@@ -1752,16 +1703,13 @@ CL_BfgParticles(entity_t *ent)
 		forward[1] = cp * sy;
 		forward[2] = -sp;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 
 		dist = (float)sin(ltime + i) * 64;
@@ -1811,15 +1759,12 @@ CL_TrapParticles(entity_t *ent)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -1856,16 +1801,13 @@ CL_TrapParticles(entity_t *ent)
 			{
 				for (k = -2; k <= 4; k += 4)
 				{
-					if (!free_particles)
+					p = CL_AllocParticle();
+
+					if (!p)
 					{
 						return;
 					}
 
-					p = free_particles;
-					free_particles = p->next;
-					p->next = active_particles;
-					active_particles = p;
-
 					p->time = time;
 					p->color = 0xe0 + (randk() & 3);
 					p->alpha = 1.0;
@@ -1902,16 +1844,13 @@ CL_BFGExplosionParticles(vec3_t org)
 
 	for (i = 0; i < 256; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = 0xd0 + (randk() & 7);
 
@@ -1946,16 +1885,13 @@ CL_TeleportParticles(vec3_t org)
 		{
 			for (k = -16; k <= 32; k += 4)
 			{
-				if (!free_particles)
+				p = CL_AllocParticle();
+
+				if (!p)
 				{
 					return;
 				}
 
-				p = free_particles;
-				free_particles = p->next;
-				p->next = active_particles;
-				active_particles = p;
-
 				p->time = time;
 				p->color = 7 + (randk() & 7);
 				p->alpha = 1.0;
@@ -2088,16 +2024,13 @@ CL_DebugTrail(vec3_t start, vec3_t end)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = (float)cl.time;
 		VectorClear(p->accel);
 		VectorClear(p->vel);
@@ -2131,15 +2064,12 @@ CL_SmokeTrail(vec3_t start, vec3_t end, int colorStart,
 	{
 		len -= spacing;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2182,17 +2112,15 @@ CL_ForceWall(vec3_t start, vec3_t end, int color8)
 	{
 		len -= 4;
 
-		if (!free_particles)
-		{
-			return;
-		}
-
 		if (frandk() > 0.3)
 		{
-			p = free_particles;
-			free_particles = p->next;
-			p->next = active_particles;
-			active_particles = p;
+			p = CL_AllocParticle();
+
+			if (!p)
+			{
+				return;
+			}
+
 			VectorClear(p->accel);
 
 			p->time = time;
@@ -2240,16 +2168,13 @@ CL_BubbleTrail2(vec3_t start, vec3_t end, int dist)
 
 	for (i = 0; i < len; i += dist)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		VectorClear(p->accel);
 		p->time = time;
 
@@ -2320,16 +2245,13 @@ CL_Heatbeam(vec3_t start, vec3_t forward)
 
 		for (rot = 0; rot < M_PI * 2; rot += rstep)
 		{
-			if (!free_particles)
+			p = CL_AllocParticle();
+
+			if (!p)
 			{
 				return;
 			}
 
-			p = free_particles;
-			free_particles = p->next;
-			p->next = active_particles;
-			active_particles = p;
-
 			p->time = time;
 			VectorClear(p->accel);
 			variance = 0.5;
@@ -2380,16 +2302,13 @@ CL_ParticleSteamEffect(vec3_t org, vec3_t dir, int color,
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color + (randk() & 7);
 
@@ -2426,16 +2345,13 @@ CL_ParticleSteamEffect2(cl_sustain_t *self)
 
 	for (i = 0; i < self->count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = cl.time;
 		p->color = self->color + (randk() & 7);
 
@@ -2489,15 +2405,12 @@ CL_TrackerTrail(vec3_t start, vec3_t end, int particleColor)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2532,15 +2445,12 @@ CL_Tracker_Shell(vec3_t origin)
 
 	for (i = 0; i < 300; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2569,15 +2479,12 @@ CL_MonsterPlasma_Shell(vec3_t origin)
 
 	for (i = 0; i < 40; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2609,15 +2516,12 @@ CL_Widowbeamout(cl_sustain_t *self)
 
 	for (i = 0; i < 300; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2649,15 +2553,12 @@ CL_Nukeblast(cl_sustain_t *self)
 
 	for (i = 0; i < 700; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2687,16 +2588,13 @@ CL_WidowSplash(vec3_t org)
 
 	for (i = 0; i < 256; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = colortable[randk() & 3];
 		dir[0] = crandk();
@@ -2725,15 +2623,12 @@ CL_Tracker_Explode(vec3_t origin)
 
 	for (i = 0; i < 300; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2776,15 +2671,12 @@ CL_TagTrail(vec3_t start, vec3_t end, int color)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
@@ -2816,16 +2708,13 @@ CL_ColorExplosionParticles(vec3_t org, int color, int run)
 
 	for (i = 0; i < 128; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color + (randk() % run);
 
@@ -2862,16 +2751,13 @@ CL_ParticleSmokeEffect(vec3_t org, vec3_t dir, int color,
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color + (randk() & 7);
 
@@ -2911,16 +2797,13 @@ CL_BlasterParticles2(vec3_t org, vec3_t dir, unsigned int color)
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color + (randk() & 7);
 		d = (float)(randk() & 15);
@@ -2966,15 +2849,12 @@ CL_BlasterTrail2(vec3_t start, vec3_t end)
 	{
 		len -= dec;
 
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
-
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
 		VectorClear(p->accel);
 
 		p->time = time;
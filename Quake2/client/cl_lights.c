@@ -108,7 +108,7 @@ CL_AddLightStyles(void)
 	}
 }
 
-cdlight_t cl_dlights[MAX_DLIGHTS];
+cdlight_t cl_dlights[MAX_CL_DLIGHTS];
 
 void
 CL_ClearDlights(void)
@@ -127,7 +127,7 @@ CL_AllocDlight(int key)
 	{
 		dl = cl_dlights;
 
-		for (i = 0; i < MAX_DLIGHTS; i++, dl++)
+		for (i = 0; i < MAX_CL_DLIGHTS; i++, dl++)
 		{
 			if (dl->key == key)
 			{
@@ -139,7 +139,7 @@ CL_AllocDlight(int key)
 	/* then look for anything else */
 	dl = cl_dlights;
 
-	for (i = 0; i < MAX_DLIGHTS; i++, dl++)
+	for (i = 0; i < MAX_CL_DLIGHTS; i++, dl++)
 	{
 		if (dl->die < cl.time)
 		{
@@ -174,7 +174,7 @@ CL_RunDLights(void)
 
 	dl = cl_dlights;
 
-	for (i = 0; i < MAX_DLIGHTS; i++, dl++)
+	for (i = 0; i < MAX_CL_DLIGHTS; i++, dl++)
 	{
 		if (!dl->radius)
 		{
@@ -201,16 +201,28 @@ CL_AddDLights(void)
 {
 	int i;
 	cdlight_t *dl;
+	float vieworgdist;
 
+	vieworgdist = DotProduct(cl.refdef.vieworg, cl.v_forward);
 	dl = cl_dlights;
 
-	for (i = 0; i < MAX_DLIGHTS; i++, dl++)
+	for (i = 0; i < MAX_CL_DLIGHTS; i++, dl++)
 	{
 		if (!dl->radius)
 		{
 			continue;
 		}
 
+		/* Everything a light touches lies within its radius.
+		   If that sphere is completely behind the view plane
+		   the light can't affect anything visible, so don't
+		   let it take one of the refreshers light slots. */
+		if (DotProduct(dl->origin, cl.v_forward) - vieworgdist <
+			-fabs(dl->radius))
+		{
+			continue;
+		}
+
 		V_AddLight(dl->origin, dl->radius, dl->color[0], dl->color[1], dl->color[2]);
 	}
 }
@@ -54,6 +54,7 @@ cvar_t *cl_predict;
 cvar_t *cl_showfps;
 cvar_t *cl_gun;
 cvar_t *cl_add_particles;
+cvar_t *cl_maxparticles;
 cvar_t *cl_add_lights;
 cvar_t *cl_add_entities;
 cvar_t *cl_add_blend;
@@ -305,6 +306,105 @@ CL_Setenv_f(void)
 	}
 }
 
+/* Render frame time histogram. Bucket i counts the
+   frames that took less than 2^i milliseconds, the
+   last one everything slower. */
+#define FRAMEHIST_BUCKETS 8
+
+static int framehist[FRAMEHIST_BUCKETS];
+static int framehist_parsed[FRAMEHIST_BUCKETS];
+
+/* Per frame times of the running timedemo,
+   reported as percentiles when it ends. */
+#define TIMEDEMO_SAMPLES 65536
+
+static int timedemo_usec[TIMEDEMO_SAMPLES];
+static int timedemo_numsamples;
+
+static int
+CL_CompareSamples(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+void
+CL_TimedemoReport(void)
+{
+	int n;
+
+	n = timedemo_numsamples;
+	timedemo_numsamples = 0;
+
+	if (!n)
+	{
+		return;
+	}
+
+	qsort(timedemo_usec, n, sizeof(int), CL_CompareSamples);
+
+	Com_Printf("frame cpu ms: p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n",
+			timedemo_usec[n / 2] / 1000.0f,
+			timedemo_usec[n * 9 / 10] / 1000.0f,
+			timedemo_usec[n * 99 / 100] / 1000.0f,
+			timedemo_usec[n - 1] / 1000.0f);
+}
+
+static void
+CL_RecordFrameTime(long long usec, qboolean parsed)
+{
+	int i;
+
+	if (cl_timedemo->value && (cls.state == ca_active) &&
+		(timedemo_numsamples < TIMEDEMO_SAMPLES))
+	{
+		timedemo_usec[timedemo_numsamples++] = (int)usec;
+	}
+
+	for (i = 0; i < FRAMEHIST_BUCKETS - 1; i++)
+	{
+		if (usec < (1000LL << i))
+		{
+			break;
+		}
+	}
+
+	framehist[i]++;
+
+	if (parsed)
+	{
+		framehist_parsed[i]++;
+	}
+}
+
+void
+CL_FrameHist_f(void)
+{
+	int i;
+
+	if ((Cmd_Argc() == 2) && !strcmp(Cmd_Argv(1), "reset"))
+	{
+		memset(framehist, 0, sizeof(framehist));
+		memset(framehist_parsed, 0, sizeof(framehist_parsed));
+		return;
+	}
+
+	Com_Printf("render frame times (frames / with packets parsed):\n");
+
+	for (i = 0; i < FRAMEHIST_BUCKETS; i++)
+	{
+		if (i < FRAMEHIST_BUCKETS - 1)
+		{
+			Com_Printf("  < %3i ms: %8i / %8i\n", 1 << i,
+					framehist[i], framehist_parsed[i]);
+		}
+		else
+		{
+			Com_Printf(" >= %3i ms: %8i / %8i\n", 1 << (i - 1),
+					framehist[i], framehist_parsed[i]);
+		}
+	}
+}
+
 void
 CL_Pause_f(void)
 {
@@ -518,6 +618,7 @@ CL_InitLocal(void)
 	cl_add_blend = Cvar_Get("cl_blend", "1", 0);
 	cl_add_lights = Cvar_Get("cl_lights", "1", 0);
 	cl_add_particles = Cvar_Get("cl_particles", "1", 0);
+	cl_maxparticles = Cvar_Get("cl_maxparticles", "4096", CVAR_ARCHIVE);
 	cl_add_entities = Cvar_Get("cl_entities", "1", 0);
 	cl_gun = Cvar_Get("cl_gun", "2", CVAR_ARCHIVE);
 	cl_footsteps = Cvar_Get("cl_footsteps", "1", 0);
@@ -579,6 +680,7 @@ CL_InitLocal(void)
 	/* register our commands */
 	Cmd_AddCommand("cmd", CL_ForwardToServer_f);
 	Cmd_AddCommand("pause", CL_Pause_f);
+	Cmd_AddCommand("framehist", CL_FrameHist_f);
 	Cmd_AddCommand("pingservers", CL_PingServers_f);
 	Cmd_AddCommand("skins", CL_Skins_f);
 
@@ -751,6 +853,9 @@ CL_Frame(int packetdelta, int renderdelta, int timedelta, qboolean packetframe,
 {
     static int extratime;
 	static int lasttimecalled;
+	long long framestart = 0;
+	int sequence;
+	qboolean parsed = false;
 
 	// Dedicated?
 	if (dedicated->value)
@@ -781,6 +886,11 @@ CL_Frame(int packetdelta, int renderdelta, int timedelta, qboolean packetframe,
 		cls.netchan.last_received = Sys_Milliseconds();
 	}
 
+	if (renderframe)
+	{
+		framestart = Sys_Microseconds();
+	}
+
 	// Reset power shield / power screen sound counter.
 	num_power_sounds = 0;
 
@@ -796,7 +906,10 @@ CL_Frame(int packetdelta, int renderdelta, int timedelta, qboolean packetframe,
 	// Update input stuff
 	if (packetframe || renderframe)
 	{
+		sequence = cls.netchan.incoming_sequence;
 		CL_ReadPackets();
+		parsed = (cls.netchan.incoming_sequence != sequence);
+
 		CL_UpdateWindowedMouse();
 		IN_Update();
 		Cbuf_Execute();
@@ -864,6 +977,8 @@ CL_Frame(int packetdelta, int renderdelta, int timedelta, qboolean packetframe,
 		/* Update framecounter */
 		cls.framecount++;
 
+		CL_RecordFrameTime(Sys_Microseconds() - framestart, parsed);
+
 		if (log_stats->value)
 		{
 			if (cls.state == ca_active)
@@ -309,6 +309,8 @@ CL_Disconnect(void)
 					cl.timedemo_frames, time / 1000.0,
 					cl.timedemo_frames * 1000.0 / time);
 		}
+
+		CL_TimedemoReport();
 	}
 
 	VectorClear(cl.refdef.blend);
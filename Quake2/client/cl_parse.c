@@ -62,6 +62,9 @@ void
 CL_RegisterSounds(void)
 {
 	int i;
+	int start;
+
+	start = Sys_Milliseconds();
 
 	S_BeginRegistration();
 	CL_RegisterTEntSounds();
@@ -78,6 +81,8 @@ CL_RegisterSounds(void)
 	}
 
 	S_EndRegistration();
+
+	Com_DPrintf("Sound registration took %i ms\n", Sys_Milliseconds() - start);
 }
 
 /*
@@ -1020,6 +1025,8 @@ CL_LoadClientinfo(clientinfo_t *ci, char *s)
 		ci->icon = Draw_FindPic(ci->iconname);
 	}
 
+	S_RegisterSexedSounds(ci->cinfo, ci->sexedsounds, &ci->sexedsequence);
+
 	/* must have loaded all data types to be valid */
 	if (!ci->skin || !ci->icon || !ci->model || !ci->weaponmodel[0])
 	{
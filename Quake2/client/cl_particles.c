@@ -26,24 +26,61 @@
 
 #include "header/client.h"
 
-cparticle_t *active_particles, *free_particles;
-cparticle_t particles[MAX_PARTICLES];
-int cl_numparticles = MAX_PARTICLES;
+/* Particles live in one dense array. The first
+   cl_activeparticles entries are alive, the rest
+   is free. CL_AddParticles() compacts the array
+   in place each frame, so there's no free list to
+   chase through memory. The capacity is set by
+   cl_maxparticles and only changes on map load. */
+static cparticle_t *particles;
+static int cl_numparticles;
+static int cl_activeparticles;
 
 void
 CL_ClearParticles(void)
 {
-	int i;
+	int count;
 
-	free_particles = &particles[0];
-	active_particles = NULL;
+	count = (int)cl_maxparticles->value;
 
-	for (i = 0; i < cl_numparticles; i++)
+	if (count < MAX_PARTICLES)
 	{
-		particles[i].next = &particles[i + 1];
+		count = MAX_PARTICLES;
 	}
+	else if (count > MAX_PARTICLES_LIMIT)
+	{
+		count = MAX_PARTICLES_LIMIT;
+	}
+
+	if (!particles || (count != cl_numparticles))
+	{
+		if (particles)
+		{
+			Z_Free(particles);
+		}
+
+		particles = Z_Malloc(count * sizeof(cparticle_t));
+		cl_numparticles = count;
 
-	particles[cl_numparticles - 1].next = NULL;
+		V_SetMaxParticles(count);
+	}
+
+	cl_activeparticles = 0;
+}
+
+/*
+ * Returns a fresh particle or NULL
+ * if the budget is exhausted.
+ */
+cparticle_t *
+CL_AllocParticle(void)
+{
+	if (cl_activeparticles >= cl_numparticles)
+	{
+		return NULL;
+	}
+
+	return &particles[cl_activeparticles++];
 }
 
 void
@@ -55,16 +92,13 @@ CL_ParticleEffect(vec3_t org, vec3_t dir, int color, int count)
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = cl.time;
 		p->color = color + (randk() & 7);
 		d = randk() & 31;
@@ -95,16 +129,13 @@ CL_ParticleEffect2(vec3_t org, vec3_t dir, int color, int count)
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color + (randk() & 7);
 
@@ -136,16 +167,13 @@ CL_ParticleEffect3(vec3_t org, vec3_t dir, int color, int count)
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 		p->color = color;
 
@@ -168,19 +196,18 @@ CL_ParticleEffect3(vec3_t org, vec3_t dir, int color, int count)
 void
 CL_AddParticles(void)
 {
-	cparticle_t *p, *next;
+	cparticle_t *p;
 	float alpha;
 	float time, time2;
 	vec3_t org;
 	int color;
-	cparticle_t *active, *tail;
+	int i, active;
 
-	active = NULL;
-	tail = NULL;
+	active = 0;
 
-	for (p = active_particles; p; p = next)
+	for (i = 0; i < cl_activeparticles; i++)
 	{
-		next = p->next;
+		p = &particles[i];
 
 		if (p->alphavel != INSTANT_PARTICLE)
 		{
@@ -190,8 +217,6 @@ CL_AddParticles(void)
 			if (alpha <= 0)
 			{
 				/* faded out */
-				p->next = free_particles;
-				free_particles = p;
 				continue;
 			}
 		}
@@ -201,19 +226,6 @@ CL_AddParticles(void)
 			alpha = p->alpha;
 		}
 
-		p->next = NULL;
-
-		if (!tail)
-		{
-			active = tail = p;
-		}
-
-		else
-		{
-			tail->next = p;
-			tail = p;
-		}
-
 		if (alpha > 1.0f)
 		{
 			alpha = 1;
@@ -233,9 +245,17 @@ CL_AddParticles(void)
 			p->alphavel = 0.0;
 			p->alpha = 0.0;
 		}
+
+		/* keep the survivors packed at the front */
+		if (i != active)
+		{
+			particles[active] = *p;
+		}
+
+		active++;
 	}
 
-	active_particles = active;
+	cl_activeparticles = active;
 }
 
 void
@@ -251,16 +271,13 @@ CL_GenericParticleEffect(vec3_t org, vec3_t dir, int color,
 
 	for (i = 0; i < count; i++)
 	{
-		if (!free_particles)
+		p = CL_AllocParticle();
+
+		if (!p)
 		{
 			return;
 		}
 
-		p = free_particles;
-		free_particles = p->next;
-		p->next = active_particles;
-		active_particles = p;
-
 		p->time = time;
 
 		if (numcolors > 1)
@@ -27,6 +27,26 @@
 
 #include "header/client.h"
 
+/*
+ * Prediction result after the last command that was
+ * already sent. Sent commands never change and the
+ * world only changes with a new server frame, so until
+ * then only the commands after this one need to run.
+ */
+typedef struct
+{
+	qboolean valid;
+	int servercount;
+	int serverframe;
+	int ack;
+	float airaccelerate;
+	int sequence;
+	pmove_state_t s;
+	vec3_t viewangles;
+} predcache_t;
+
+static predcache_t predcache;
+
 void
 CL_CheckPredictionError(void)
 {
@@ -277,6 +297,19 @@ CL_PredictMovement(void)
 	pm_airaccelerate = atof(cl.configstrings[CS_AIRACCEL]);
 	pm.s = cl.frame.playerstate.pmove;
 
+	/* continue from the cached result if it's still valid */
+	if (predcache.valid &&
+		(predcache.servercount == cl.servercount) &&
+		(predcache.serverframe == cl.frame.serverframe) &&
+		(predcache.ack == ack) &&
+		(predcache.airaccelerate == pm_airaccelerate) &&
+		(predcache.sequence > ack) && (predcache.sequence < current))
+	{
+		pm.s = predcache.s;
+		VectorCopy(predcache.viewangles, pm.viewangles);
+		ack = predcache.sequence;
+	}
+
 	/* run frames */
 	while (++ack <= current)
 	{
@@ -284,16 +317,27 @@ CL_PredictMovement(void)
 		cmd = &cl.cmds[frame];
 
 		// Ignore null entries
-		if (!cmd->msec)
+		if (cmd->msec)
 		{
-			continue;
-		}
+			pm.cmd = *cmd;
+			Pmove(&pm);
 
-		pm.cmd = *cmd;
-		Pmove(&pm);
+			/* save for debug checking */
+			VectorCopy(pm.s.origin, cl.predicted_origins[frame]);
+		}
 
-		/* save for debug checking */
-		VectorCopy(pm.s.origin, cl.predicted_origins[frame]);
+		/* the command at current is still being built */
+		if (ack == current - 1)
+		{
+			predcache.valid = true;
+			predcache.servercount = cl.servercount;
+			predcache.serverframe = cl.frame.serverframe;
+			predcache.ack = cls.netchan.incoming_acknowledged;
+			predcache.airaccelerate = pm_airaccelerate;
+			predcache.sequence = ack;
+			predcache.s = pm.s;
+			VectorCopy(pm.viewangles, predcache.viewangles);
+		}
 	}
 
 	step = pm.s.origin[2] - (int)(cl.predicted_origin[2] * 8);
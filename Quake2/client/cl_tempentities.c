@@ -48,7 +48,13 @@ typedef struct
 #define MAX_BEAMS 64
 #define MAX_LASERS 64
 
+/* The temp entity pools below are kept packed: the
+   first cl_num* slots are in use, everything after
+   them is free. Expired entries are squeezed out
+   when the pool is walked for rendering, so the
+   per-frame loops only touch live effects. */
 explosion_t cl_explosions[MAX_EXPLOSIONS];
+int cl_numexplosions;
 
 typedef struct
 {
@@ -61,7 +67,9 @@ typedef struct
 } beam_t;
 
 beam_t cl_beams[MAX_BEAMS];
+int cl_numbeams;
 beam_t cl_playerbeams[MAX_BEAMS];
+int cl_numplayerbeams;
 
 typedef struct
 {
@@ -69,8 +77,10 @@ typedef struct
 	int endtime;
 } laser_t;
 laser_t cl_lasers[MAX_LASERS];
+int cl_numlasers;
 
 cl_sustain_t cl_sustains[MAX_SUSTAINS];
+int cl_numsustains;
 
 extern void CL_TeleportParticles(vec3_t org);
 void CL_BlasterParticles(vec3_t org, vec3_t dir);
@@ -189,6 +199,12 @@ CL_ClearTEnts(void)
 
 	memset(cl_playerbeams, 0, sizeof(cl_playerbeams));
 	memset(cl_sustains, 0, sizeof(cl_sustains));
+
+	cl_numbeams = 0;
+	cl_numexplosions = 0;
+	cl_numlasers = 0;
+	cl_numplayerbeams = 0;
+	cl_numsustains = 0;
 }
 
 explosion_t *
@@ -198,13 +214,11 @@ CL_AllocExplosion(void)
 	float time;
 	int index;
 
-	for (i = 0; i < MAX_EXPLOSIONS; i++)
+	if (cl_numexplosions < MAX_EXPLOSIONS)
 	{
-		if (cl_explosions[i].type == ex_free)
-		{
-			memset(&cl_explosions[i], 0, sizeof(cl_explosions[i]));
-			return &cl_explosions[i];
-		}
+		index = cl_numexplosions++;
+		memset(&cl_explosions[index], 0, sizeof(cl_explosions[index]));
+		return &cl_explosions[index];
 	}
 
 	/* find the oldest explosion */
@@ -224,6 +238,71 @@ CL_AllocExplosion(void)
 	return &cl_explosions[index];
 }
 
+/*
+ * Returns an unused or expired slot of a beam pool,
+ * or NULL if all beams are still alive.
+ */
+static beam_t *
+CL_AllocBeam(beam_t *beams, int *numbeams)
+{
+	beam_t *b;
+	int i;
+
+	for (i = 0, b = beams; i < *numbeams; i++, b++)
+	{
+		if (!b->model || (b->endtime < cl.time))
+		{
+			return b;
+		}
+	}
+
+	if (*numbeams < MAX_BEAMS)
+	{
+		return &beams[(*numbeams)++];
+	}
+
+	return NULL;
+}
+
+/*
+ * Squeezes expired beams out of a beam pool.
+ */
+static void
+CL_ExpireBeams(beam_t *beams, int *numbeams)
+{
+	int i, active;
+
+	active = 0;
+
+	for (i = 0; i < *numbeams; i++)
+	{
+		if (!beams[i].model || (beams[i].endtime < cl.time))
+		{
+			continue;
+		}
+
+		if (i != active)
+		{
+			beams[active] = beams[i];
+		}
+
+		active++;
+	}
+
+	*numbeams = active;
+}
+
+static cl_sustain_t *
+CL_AllocSustain(void)
+{
+	if (cl_numsustains >= MAX_SUSTAINS)
+	{
+		return NULL;
+	}
+
+	return &cl_sustains[cl_numsustains++];
+}
+
 void
 CL_SmokeAndFlash(vec3_t origin)
 {
@@ -276,7 +355,7 @@ CL_ParseBeam(struct model_s *model)
 	MSG_ReadPos(&net_message, end);
 
 	/* override any beam with the same entity */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_beams; i < cl_numbeams; i++, b++)
 	{
 		if (b->entity == ent)
 		{
@@ -291,18 +370,17 @@ CL_ParseBeam(struct model_s *model)
 	}
 
 	/* find a free beam */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	b = CL_AllocBeam(cl_beams, &cl_numbeams);
+
+	if (b)
 	{
-		if (!b->model || (b->endtime < cl.time))
-		{
-			b->entity = ent;
-			b->model = model;
-			b->endtime = cl.time + 200;
-			VectorCopy(start, b->start);
-			VectorCopy(end, b->end);
-			VectorClear(b->offset);
-			return;
-		}
+		b->entity = ent;
+		b->model = model;
+		b->endtime = cl.time + 200;
+		VectorCopy(start, b->start);
+		VectorCopy(end, b->end);
+		VectorClear(b->offset);
+		return;
 	}
 
 	Com_Printf("beam list overflow!\n");
@@ -324,7 +402,7 @@ CL_ParseBeam2(struct model_s *model)
 	MSG_ReadPos(&net_message, offset);
 
 	/* override any beam with the same entity */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_beams; i < cl_numbeams; i++, b++)
 	{
 		if (b->entity == ent)
 		{
@@ -339,18 +417,17 @@ CL_ParseBeam2(struct model_s *model)
 	}
 
 	/* find a free beam */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	b = CL_AllocBeam(cl_beams, &cl_numbeams);
+
+	if (b)
 	{
-		if (!b->model || (b->endtime < cl.time))
-		{
-			b->entity = ent;
-			b->model = model;
-			b->endtime = cl.time + 200;
-			VectorCopy(start, b->start);
-			VectorCopy(end, b->end);
-			VectorCopy(offset, b->offset);
-			return;
-		}
+		b->entity = ent;
+		b->model = model;
+		b->endtime = cl.time + 200;
+		VectorCopy(start, b->start);
+		VectorCopy(end, b->end);
+		VectorCopy(offset, b->offset);
+		return;
 	}
 
 	Com_Printf("beam list overflow!\n");
@@ -392,7 +469,7 @@ CL_ParsePlayerBeam(struct model_s *model)
 	/* Override any beam with the same entity
 	   For player beams, we only want one per
 	   player (entity) so... */
-	for (i = 0, b = cl_playerbeams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_playerbeams; i < cl_numplayerbeams; i++, b++)
 	{
 		if (b->entity == ent)
 		{
@@ -407,19 +484,18 @@ CL_ParsePlayerBeam(struct model_s *model)
 	}
 
 	/* find a free beam */
-	for (i = 0, b = cl_playerbeams; i < MAX_BEAMS; i++, b++)
+	b = CL_AllocBeam(cl_playerbeams, &cl_numplayerbeams);
+
+	if (b)
 	{
-		if (!b->model || (b->endtime < cl.time))
-		{
-			b->entity = ent;
-			b->model = model;
-			b->endtime = cl.time + 100; /* this needs to be 100 to
-										   prevent multiple heatbeams */
-			VectorCopy(start, b->start);
-			VectorCopy(end, b->end);
-			VectorCopy(offset, b->offset);
-			return;
-		}
+		b->entity = ent;
+		b->model = model;
+		b->endtime = cl.time + 100; /* this needs to be 100 to
+									  prevent multiple heatbeams */
+		VectorCopy(start, b->start);
+		VectorCopy(end, b->end);
+		VectorCopy(offset, b->offset);
+		return;
 	}
 
 	Com_Printf("beam list overflow!\n");
@@ -442,7 +518,7 @@ CL_ParseLightning(struct model_s *model)
 
 	/* override any beam with the same
 	   source AND destination entities */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_beams; i < cl_numbeams; i++, b++)
 	{
 		if ((b->entity == srcEnt) && (b->dest_entity == destEnt))
 		{
@@ -458,19 +534,18 @@ CL_ParseLightning(struct model_s *model)
 	}
 
 	/* find a free beam */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	b = CL_AllocBeam(cl_beams, &cl_numbeams);
+
+	if (b)
 	{
-		if (!b->model || (b->endtime < cl.time))
-		{
-			b->entity = srcEnt;
-			b->dest_entity = destEnt;
-			b->model = model;
-			b->endtime = cl.time + 200;
-			VectorCopy(start, b->start);
-			VectorCopy(end, b->end);
-			VectorClear(b->offset);
-			return srcEnt;
-		}
+		b->entity = srcEnt;
+		b->dest_entity = destEnt;
+		b->model = model;
+		b->endtime = cl.time + 200;
+		VectorCopy(start, b->start);
+		VectorCopy(end, b->end);
+		VectorClear(b->offset);
+		return srcEnt;
 	}
 
 	Com_Printf("beam list overflow!\n");
@@ -488,50 +563,52 @@ CL_ParseLaser(int colors)
 	MSG_ReadPos(&net_message, start);
 	MSG_ReadPos(&net_message, end);
 
-	for (i = 0, l = cl_lasers; i < MAX_LASERS; i++, l++)
+	for (i = 0, l = cl_lasers; i < cl_numlasers; i++, l++)
 	{
 		if (l->endtime < cl.time)
 		{
-			l->ent.flags = RF_TRANSLUCENT | RF_BEAM;
-			VectorCopy(start, l->ent.origin);
-			VectorCopy(end, l->ent.oldorigin);
-			l->ent.alpha = 0.30f;
-			l->ent.skinnum = (colors >> ((randk() % 4) * 8)) & 0xff;
-			l->ent.model = NULL;
-			l->ent.frame = 4;
-			l->endtime = cl.time + 100;
+			break;
+		}
+	}
+
+	if (i == cl_numlasers)
+	{
+		if (cl_numlasers >= MAX_LASERS)
+		{
 			return;
 		}
+
+		cl_numlasers++;
 	}
+
+	l->ent.flags = RF_TRANSLUCENT | RF_BEAM;
+	VectorCopy(start, l->ent.origin);
+	VectorCopy(end, l->ent.oldorigin);
+	l->ent.alpha = 0.30f;
+	l->ent.skinnum = (colors >> ((randk() % 4) * 8)) & 0xff;
+	l->ent.model = NULL;
+	l->ent.frame = 4;
+	l->endtime = cl.time + 100;
 }
 
 void
 CL_ParseSteam(void)
 {
 	vec3_t pos, dir;
-	int id, i;
+	int id;
 	int r;
 	int cnt;
 	int color;
 	int magnitude;
-	cl_sustain_t *s, *free_sustain;
+	cl_sustain_t *s;
 
 	id = MSG_ReadShort(&net_message); /* an id of -1 is an instant effect */
 
 	if (id != -1) /* sustains */
 	{
-		free_sustain = NULL;
-
-		for (i = 0, s = cl_sustains; i < MAX_SUSTAINS; i++, s++)
-		{
-			if (s->id == 0)
-			{
-				free_sustain = s;
-				break;
-			}
-		}
+		s = CL_AllocSustain();
 
-		if (free_sustain)
+		if (s)
 		{
 			s->id = id;
 			s->count = MSG_ReadByte(&net_message);
@@ -572,23 +649,14 @@ void
 CL_ParseWidow(void)
 {
 	vec3_t pos;
-	int id, i;
-	cl_sustain_t *s, *free_sustain;
+	int id;
+	cl_sustain_t *s;
 
 	id = MSG_ReadShort(&net_message);
 
-	free_sustain = NULL;
-
-	for (i = 0, s = cl_sustains; i < MAX_SUSTAINS; i++, s++)
-	{
-		if (s->id == 0)
-		{
-			free_sustain = s;
-			break;
-		}
-	}
+	s = CL_AllocSustain();
 
-	if (free_sustain)
+	if (s)
 	{
 		s->id = id;
 		MSG_ReadPos(&net_message, s->org);
@@ -608,21 +676,11 @@ void
 CL_ParseNuke(void)
 {
 	vec3_t pos;
-	int i;
-	cl_sustain_t *s, *free_sustain;
-
-	free_sustain = NULL;
+	cl_sustain_t *s;
 
-	for (i = 0, s = cl_sustains; i < MAX_SUSTAINS; i++, s++)
-	{
-		if (s->id == 0)
-		{
-			free_sustain = s;
-			break;
-		}
-	}
+	s = CL_AllocSustain();
 
-	if (free_sustain)
+	if (s)
 	{
 		s->id = 21000;
 		MSG_ReadPos(&net_message, s->org);
@@ -1269,14 +1327,11 @@ CL_AddBeams(void)
 	float len, steps;
 	float model_length;
 
+	CL_ExpireBeams(cl_beams, &cl_numbeams);
+
 	/* update beams */
-	for (i = 0, b = cl_beams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_beams; i < cl_numbeams; i++, b++)
 	{
-		if (!b->model || (b->endtime < cl.time))
-		{
-			continue;
-		}
-
 		/* if coming from the player, update the start position */
 		if (b->entity == cl.playernum + 1) /* entity 0 is the world */
 		{
@@ -1444,16 +1499,13 @@ CL_AddPlayerBeams(void)
 		hand_multiplier = 1;
 	}
 
+	CL_ExpireBeams(cl_playerbeams, &cl_numplayerbeams);
+
 	/* update beams */
-	for (i = 0, b = cl_playerbeams; i < MAX_BEAMS; i++, b++)
+	for (i = 0, b = cl_playerbeams; i < cl_numplayerbeams; i++, b++)
 	{
 		vec3_t f, r, u;
 
-		if (!b->model || (b->endtime < cl.time))
-		{
-			continue;
-		}
-
 		if (cl_mod_heatbeam && (b->model == cl_mod_heatbeam))
 		{
 			/* if coming from the player, update the start position */
@@ -1691,14 +1743,15 @@ void
 CL_AddExplosions(void)
 {
 	entity_t *ent;
-	int i;
+	int i, active;
 	explosion_t *ex;
 	float frac;
 	int f;
 
 	memset(&ent, 0, sizeof(ent));
+	active = 0;
 
-	for (i = 0, ex = cl_explosions; i < MAX_EXPLOSIONS; i++, ex++)
+	for (i = 0, ex = cl_explosions; i < cl_numexplosions; i++, ex++)
 	{
 		if (ex->type == ex_free)
 		{
@@ -1814,44 +1867,75 @@ CL_AddExplosions(void)
 		ent->backlerp = 1.0f - cl.lerpfrac;
 
 		V_AddEntity(ent);
+
+		if (i != active)
+		{
+			cl_explosions[active] = *ex;
+		}
+
+		active++;
 	}
+
+	cl_numexplosions = active;
 }
 
 void
 CL_AddLasers(void)
 {
 	laser_t *l;
-	int i;
+	int i, active;
+
+	active = 0;
 
-	for (i = 0, l = cl_lasers; i < MAX_LASERS; i++, l++)
+	for (i = 0, l = cl_lasers; i < cl_numlasers; i++, l++)
 	{
-		if (l->endtime >= cl.time)
+		if (l->endtime < cl.time)
+		{
+			continue;
+		}
+
+		V_AddEntity(&l->ent);
+
+		if (i != active)
 		{
-			V_AddEntity(&l->ent);
+			cl_lasers[active] = *l;
 		}
+
+		active++;
 	}
+
+	cl_numlasers = active;
 }
 
 void
 CL_ProcessSustain()
 {
 	cl_sustain_t *s;
-	int i;
+	int i, active;
+
+	active = 0;
 
-	for (i = 0, s = cl_sustains; i < MAX_SUSTAINS; i++, s++)
+	for (i = 0, s = cl_sustains; i < cl_numsustains; i++, s++)
 	{
-		if (s->id)
+		if (!s->id || (s->endtime < cl.time))
 		{
-			if ((s->endtime >= cl.time) && (cl.time >= s->nextthink))
-			{
-				s->think(s);
-			}
-			else if (s->endtime < cl.time)
-			{
-				s->id = 0;
-			}
+			continue;
+		}
+
+		if (cl.time >= s->nextthink)
+		{
+			s->think(s);
 		}
+
+		if (i != active)
+		{
+			cl_sustains[active] = *s;
+		}
+
+		active++;
 	}
+
+	cl_numsustains = active;
 }
 
 void
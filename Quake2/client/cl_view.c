@@ -52,8 +52,15 @@ dlight_t r_dlights[MAX_DLIGHTS];
 int r_numentities;
 entity_t r_entities[MAX_ENTITIES];
 
+/* sort keys of r_entities, see V_EntitySortKey() */
+unsigned int r_entitykeys[MAX_ENTITIES];
+
+/* r_entities in drawing order, handed to the refresher */
+entity_t r_sortedentities[MAX_ENTITIES];
+
 int r_numparticles;
-particle_t r_particles[MAX_PARTICLES];
+int r_maxparticles;
+particle_t *r_particles;
 
 lightstyle_t r_lightstyles[MAX_LIGHTSTYLES];
 
@@ -73,6 +80,50 @@ V_ClearScene(void)
 	r_numparticles = 0;
 }
 
+static unsigned int
+V_HashPointer(const void *p)
+{
+	uintptr_t v;
+
+	v = (uintptr_t)p;
+
+	return (unsigned int)((v >> 4) ^ (v >> 19));
+}
+
+/*
+ * Builds the key the entity list is sorted by.
+ * Solid entities are grouped by model and then
+ * by skin, so the refresher changes state less
+ * often. Translucent entities go after all of
+ * them, sorted back to front along the view.
+ */
+static unsigned int
+V_EntitySortKey(const entity_t *ent)
+{
+	vec3_t delta;
+	float depth;
+
+	if (ent->flags & RF_TRANSLUCENT)
+	{
+		VectorSubtract(ent->origin, cl.refdef.vieworg, delta);
+		depth = DotProduct(delta, cl.v_forward);
+
+		if (depth < 0)
+		{
+			depth = 0;
+		}
+		else if (depth > 0xffff)
+		{
+			depth = 0xffff;
+		}
+
+		return 0x80000000 | (0xffff - (unsigned int)depth);
+	}
+
+	return ((V_HashPointer(ent->model) & 0x7fff) << 16) |
+		(V_HashPointer(ent->skin) & 0xffff);
+}
+
 void
 V_AddEntity(entity_t *ent)
 {
@@ -81,6 +132,7 @@ V_AddEntity(entity_t *ent)
 		return;
 	}
 
+	r_entitykeys[r_numentities] = V_EntitySortKey(ent);
 	r_entities[r_numentities++] = *ent;
 }
 
@@ -89,7 +141,7 @@ V_AddParticle(vec3_t org, unsigned int color, float alpha)
 {
 	particle_t *p;
 
-	if (r_numparticles >= MAX_PARTICLES)
+	if (r_numparticles >= r_maxparticles)
 	{
 		return;
 	}
@@ -100,6 +152,23 @@ V_AddParticle(vec3_t org, unsigned int color, float alpha)
 	p->alpha = alpha;
 }
 
+/*
+ * Resizes the refresh particle list to match
+ * the client side particle budget.
+ */
+void
+V_SetMaxParticles(int count)
+{
+	if (r_particles)
+	{
+		Z_Free(r_particles);
+	}
+
+	r_particles = Z_Malloc(count * sizeof(particle_t));
+	r_maxparticles = count;
+	r_numparticles = 0;
+}
+
 void
 V_AddLight(vec3_t org, float intensity, float r, float g, float b)
 {
@@ -146,7 +215,8 @@ V_TestParticles(void)
 	int i, j;
 	float d, r, u;
 
-	r_numparticles = MAX_PARTICLES;
+	r_numparticles = (r_maxparticles < MAX_PARTICLES) ?
+		r_maxparticles : MAX_PARTICLES;
 
 	for (i = 0; i < r_numparticles; i++)
 	{
@@ -194,6 +264,8 @@ V_TestEntities(void)
 
 		ent->model = cl.baseclientinfo.model;
 		ent->skin = cl.baseclientinfo.skin;
+
+		r_entitykeys[i] = V_EntitySortKey(ent);
 	}
 }
 
@@ -241,12 +313,15 @@ CL_PrepRefresh(void)
 	char name[MAX_QPATH];
 	float rotate;
 	vec3_t axis;
+	int start;
 
 	if (!cl.configstrings[CS_MODELS + 1][0])
 	{
 		return;
 	}
 
+	start = Sys_Milliseconds();
+
 	SCR_AddDirtyPoint(0, 0);
 	SCR_AddDirtyPoint(viddef.width - 1, viddef.height - 1);
 
@@ -354,6 +429,8 @@ CL_PrepRefresh(void)
 	/* the renderer can now free unneeded stuff */
 	R_EndRegistration();
 
+	Com_DPrintf("Refresh registration took %i ms\n", Sys_Milliseconds() - start);
+
 	/* clear any lines of console text */
 	Con_ClearNotify();
 
@@ -430,19 +507,67 @@ V_Gun_Model_f(void)
 	gun_model = R_RegisterModel(name);
 }
 
-int
-entitycmpfnc(const entity_t *a, const entity_t *b)
+/*
+ * Sorts r_entities by their keys into r_sortedentities.
+ * This is a stable LSD radix sort over the key bytes,
+ * passes where all keys share the same byte are skipped.
+ */
+static void
+V_SortEntities(void)
 {
-	/* all other models are sorted by model then skin */
-	if (a->model == b->model)
+	static unsigned int keys[2][MAX_ENTITIES];
+	static unsigned short order[2][MAX_ENTITIES];
+	int count[256];
+	int i, pass, shift, sum, tmp, src;
+	unsigned int b;
+
+	for (i = 0; i < r_numentities; i++)
 	{
-		return (a->skin == b->skin) ? 0 :
-			(a->skin > b->skin) ? 1 : -1;
+		keys[0][i] = r_entitykeys[i];
+		order[0][i] = i;
 	}
-	else
+
+	src = 0;
+
+	for (pass = 0; pass < 4; pass++)
 	{
- 		return (a->model == b->model) ? 0 :
-			(a->model > b->model) ? 1 : -1;
+		shift = pass * 8;
+
+		memset(count, 0, sizeof(count));
+
+		for (i = 0; i < r_numentities; i++)
+		{
+			count[(keys[src][i] >> shift) & 0xff]++;
+		}
+
+		if (count[(keys[src][0] >> shift) & 0xff] == r_numentities)
+		{
+			continue;
+		}
+
+		sum = 0;
+
+		for (i = 0; i < 256; i++)
+		{
+			tmp = count[i];
+			count[i] = sum;
+			sum += tmp;
+		}
+
+		for (i = 0; i < r_numentities; i++)
+		{
+			b = (keys[src][i] >> shift) & 0xff;
+			keys[src ^ 1][count[b]] = keys[src][i];
+			order[src ^ 1][count[b]] = order[src][i];
+			count[b]++;
+		}
+
+		src ^= 1;
+	}
+
+	for (i = 0; i < r_numentities; i++)
+	{
+		r_sortedentities[i] = r_entities[order[src][i]];
 	}
 }
 
@@ -550,8 +675,11 @@ V_RenderView(float stereo_separation)
 			VectorClear(cl.refdef.blend);
 		}
 
+		/* sort entities for better cache locality */
+		V_SortEntities();
+
 		cl.refdef.num_entities = r_numentities;
-		cl.refdef.entities = r_entities;
+		cl.refdef.entities = r_sortedentities;
 		cl.refdef.num_particles = r_numparticles;
 		cl.refdef.particles = r_particles;
 		cl.refdef.num_dlights = r_numdlights;
@@ -559,11 +687,6 @@ V_RenderView(float stereo_separation)
 		cl.refdef.lightstyles = r_lightstyles;
 
 		cl.refdef.rdflags = cl.frame.playerstate.rdflags;
-
-		/* sort entities for better cache locality */
-		qsort(cl.refdef.entities, cl.refdef.num_entities,
-				sizeof(cl.refdef.entities[0]), (int (*)(const void *, const void *))
-				entitycmpfnc);
 	} else if (cl.frame.valid && cl_paused->value && gl1_stereo->value) {
 		// We need to adjust the refdef in stereo mode when paused.  
 		vec3_t tmp;  
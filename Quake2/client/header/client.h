@@ -36,6 +36,11 @@
 #define	MAX_PARSE_ENTITIES	1024
 
 #define MAX_SUSTAINS		32
+
+/* size of the client side dynamic light pool. Only lights
+   that can touch the view are handed to the refresher,
+   which takes at most MAX_DLIGHTS of them. */
+#define MAX_CL_DLIGHTS		64
 #define	PARTICLE_GRAVITY 40
 #define BLASTER_PARTICLE_COLOR 0xe0
 #define INSTANT_PARTICLE -10000.0
@@ -97,6 +102,10 @@ typedef struct
 	struct model_s	*model;
 
 	struct model_s	*weaponmodel[MAX_CLIENTWEAPONMODELS];
+
+	/* resolved sexed sounds, see S_RegisterSexedSounds() */
+	struct sfx_s	*sexedsounds[MAX_SEXED_SOUNDS];
+	int		sexedsequence;
 } clientinfo_t;
 
 extern char cl_weaponmodels[MAX_CLIENTWEAPONMODELS][MAX_QPATH];
@@ -268,6 +277,7 @@ extern	cvar_t	*cl_gun;
 extern	cvar_t	*cl_add_blend;
 extern	cvar_t	*cl_add_lights;
 extern	cvar_t	*cl_add_particles;
+extern	cvar_t	*cl_maxparticles;
 extern	cvar_t	*cl_add_entities;
 extern	cvar_t	*cl_predict;
 extern	cvar_t	*cl_footsteps;
@@ -308,7 +318,7 @@ typedef struct
 } cdlight_t;
 
 extern	centity_t	cl_entities[MAX_EDICTS];
-extern	cdlight_t	cl_dlights[MAX_DLIGHTS];
+extern	cdlight_t	cl_dlights[MAX_CL_DLIGHTS];
 
 extern	entity_state_t	cl_parse_entities[MAX_PARSE_ENTITIES];
 
@@ -347,11 +357,11 @@ void CL_ParticleEffect2 (vec3_t org, vec3_t dir, int color, int count);
 void CL_ParticleEffect3 (vec3_t org, vec3_t dir, int color, int count);
 
 
+/* upper bound for cl_maxparticles */
+#define MAX_PARTICLES_LIMIT 65536
+
 typedef struct particle_s
 {
-
-	struct particle_s	*next;
-
 	float		time;
 
 	vec3_t		org;
@@ -363,6 +373,8 @@ typedef struct particle_s
 	float		alphavel;
 } cparticle_t;
 
+cparticle_t *CL_AllocParticle (void);
+
 void CL_ClearEffects (void);
 void CL_ClearTEnts (void);
 void CL_BlasterTrail (vec3_t start, vec3_t end);
@@ -432,6 +444,7 @@ void CL_Init (void);
 void CL_FixUpGender(void);
 void CL_Disconnect (void);
 void CL_Disconnect_f (void);
+void CL_TimedemoReport (void);
 void CL_GetChallengePacket (void);
 void CL_PingServers_f (void);
 void CL_Snd_Restart_f (void);
@@ -488,6 +501,7 @@ void V_Init (void);
 void V_RenderView( float stereo_separation );
 void V_AddEntity (entity_t *ent);
 void V_AddParticle (vec3_t org, unsigned int color, float alpha);
+void V_SetMaxParticles (int count);
 void V_AddLight (vec3_t org, float intensity, float r, float g, float b);
 void V_AddLightStyle (int style, float r, float g, float b);
 
@@ -393,14 +393,18 @@ R_AddDynamicLights(msurface_t *surf)
 	dlight_t *dl;
 	float *pfBL;
 	float fsacc, ftacc;
+	unsigned int bits;
 
 	smax = (surf->extents[0] >> 4) + 1;
 	tmax = (surf->extents[1] >> 4) + 1;
 	tex = surf->texinfo;
 
-	for (lnum = 0; lnum < r_newrefdef.num_dlights; lnum++)
+	/* walk the marked lights only, stop after the last one */
+	bits = surf->dlightbits;
+
+	for (lnum = 0; bits; lnum++, bits >>= 1)
 	{
-		if (!(surf->dlightbits & (1 << lnum)))
+		if (!(bits & 1))
 		{
 			continue; /* not lit by this light */
 		}
@@ -418,6 +418,44 @@ R_DrawEntitiesOnList(void)
 	glDepthMask(1); /* back to writing */
 }
 
+/* Scratch space for the particle vertex arrays. The
+   number of particles is set by the client's
+   cl_maxparticles, which may be too much for the stack. */
+static GLfloat *particle_vtx, *particle_tex, *particle_clr;
+static int particle_bufsize;
+
+static void
+R_GrowParticleBuffers(int num_particles)
+{
+	if (num_particles <= particle_bufsize)
+	{
+		return;
+	}
+
+	particle_vtx = realloc(particle_vtx, 3 * 3 * num_particles * sizeof(GLfloat));
+	particle_tex = realloc(particle_tex, 2 * 3 * num_particles * sizeof(GLfloat));
+	particle_clr = realloc(particle_clr, 4 * 3 * num_particles * sizeof(GLfloat));
+
+	if (!particle_vtx || !particle_tex || !particle_clr)
+	{
+		ri.Sys_Error(ERR_FATAL, "R_GrowParticleBuffers: Couldn't allocate %d particles",
+				num_particles);
+	}
+
+	particle_bufsize = num_particles;
+}
+
+static void
+R_FreeParticleBuffers(void)
+{
+	free(particle_vtx);
+	free(particle_tex);
+	free(particle_clr);
+
+	particle_vtx = particle_tex = particle_clr = NULL;
+	particle_bufsize = 0;
+}
+
 void
 R_DrawParticles2(int num_particles, const particle_t particles[],
 		const unsigned colortable[768])
@@ -428,14 +466,17 @@ R_DrawParticles2(int num_particles, const particle_t particles[],
 	float scale;
 	byte color[4];
  
-	GLfloat vtx[3*num_particles*3];
-	GLfloat tex[2*num_particles*3];
-	GLfloat clr[4*num_particles*3];
+	GLfloat *vtx, *tex, *clr;
 	unsigned int index_vtx = 0;
 	unsigned int index_tex = 0;
 	unsigned int index_clr = 0;
 	unsigned int j;
- 
+
+	R_GrowParticleBuffers(num_particles);
+	vtx = particle_vtx;
+	tex = particle_tex;
+	clr = particle_clr;
+
 	R_Bind(r_particletexture->texnum);
 	glDepthMask(GL_FALSE); /* no z buffering */
 	glEnable(GL_BLEND);
@@ -526,11 +567,14 @@ R_DrawParticles(void)
 		unsigned char color[4];
 		const particle_t *p;
  
-		GLfloat vtx[3*r_newrefdef.num_particles];
-		GLfloat clr[4*r_newrefdef.num_particles];
+		GLfloat *vtx, *clr;
 		unsigned int index_vtx = 0;
 		unsigned int index_clr = 0;
-  
+
+		R_GrowParticleBuffers(r_newrefdef.num_particles);
+		vtx = particle_vtx;
+		clr = particle_clr;
+
 		glDepthMask(GL_FALSE);
 		glEnable(GL_BLEND);
 		glDisable(GL_TEXTURE_2D);
@@ -725,6 +769,7 @@ R_SetupFrame(void)
 
 	c_brush_polys = 0;
 	c_alias_polys = 0;
+	c_world_draws = 0;
 
 	/* clear out the portion of the screen that the NOWORLDMODEL defines */
 	if (r_newrefdef.rdflags & RDF_NOWORLDMODEL)
@@ -1081,6 +1126,7 @@ R_RenderView(refdef_t *fd)
 	{
 		c_brush_polys = 0;
 		c_alias_polys = 0;
+		c_world_draws = 0;
 	}
 
 	R_PushDlights();
@@ -1112,9 +1158,9 @@ R_RenderView(refdef_t *fd)
 
 	if (r_speeds->value)
 	{
-		R_Printf(PRINT_ALL, "%4i wpoly %4i epoly %i tex %i lmaps\n",
+		R_Printf(PRINT_ALL, "%4i wpoly %4i epoly %i tex %i lmaps %i draws\n",
 				c_brush_polys, c_alias_polys, c_visible_textures,
-				c_visible_lightmaps);
+				c_visible_lightmaps, c_world_draws);
 	}
 
 	switch (gl_state.stereo_mode) {
@@ -1578,6 +1624,7 @@ RI_Shutdown(void)
 	ri.Cmd_RemoveCommand("gl_strings");
 
 	Mod_FreeAll();
+	R_FreeParticleBuffers();
 
 	R_ShutdownImages();
 
@@ -26,6 +26,17 @@
 
 #include "header/local.h"
 
+/* R_LerpVerts handles a whole vertex per vector op
+   with NEON (iOS and tvOS devices) or SSE2 (the
+   simulators); elsewhere the C loops are used. */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GL1_LERP_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define GL1_LERP_SSE2
+#include <emmintrin.h>
+#endif
+
 #define NUMVERTEXNORMALS 162
 #define SHADEDOT_QUANT 16
 
@@ -51,11 +62,83 @@ R_LerpVerts(int nverts, dtrivertx_t *v, dtrivertx_t *ov,
 		float frontv[3], float backv[3])
 {
 	int i;
+	qboolean shell;
 
-	if (currententity->flags &
+	shell = (currententity->flags &
 		(RF_SHELL_RED | RF_SHELL_GREEN |
 		 RF_SHELL_BLUE | RF_SHELL_DOUBLE |
-		 RF_SHELL_HALF_DAM))
+		 RF_SHELL_HALF_DAM)) != 0;
+
+#if defined(GL1_LERP_NEON) || defined(GL1_LERP_SSE2)
+	/* lerp is vec4_t per vertex, so one vector covers a vertex;
+	   the fourth lane (the normal index) is scaled by zero */
+	{
+		const float vmove[4] = {move[0], move[1], move[2], 0};
+		const float vback[4] = {backv[0], backv[1], backv[2], 0};
+		const float vfront[4] = {frontv[0], frontv[1], frontv[2], 0};
+
+#if defined(GL1_LERP_NEON)
+		float32x4_t m = vld1q_f32(vmove);
+		float32x4_t b = vld1q_f32(vback);
+		float32x4_t f = vld1q_f32(vfront);
+
+		for (i = 0; i < nverts; i++, v++, ov++, lerp += 4)
+		{
+			float32x4_t o, n, l;
+
+			o = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(
+				vreinterpret_u8_u32(vld1_dup_u32((const uint32_t *)ov))))));
+			n = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(
+				vreinterpret_u8_u32(vld1_dup_u32((const uint32_t *)v))))));
+
+			l = vaddq_f32(vaddq_f32(m, vmulq_f32(o, b)), vmulq_f32(n, f));
+
+			if (shell)
+			{
+				float *normal = r_avertexnormals[verts[i].lightnormalindex];
+				const float pn[4] = {normal[0], normal[1], normal[2], 0};
+
+				l = vaddq_f32(l, vmulq_n_f32(vld1q_f32(pn), POWERSUIT_SCALE));
+			}
+
+			vst1q_f32(lerp, l);
+		}
+#else
+		__m128 m = _mm_loadu_ps(vmove);
+		__m128 b = _mm_loadu_ps(vback);
+		__m128 f = _mm_loadu_ps(vfront);
+		__m128i zero = _mm_setzero_si128();
+
+		for (i = 0; i < nverts; i++, v++, ov++, lerp += 4)
+		{
+			__m128 o, n, l;
+			int packed[2];
+
+			memcpy(&packed[0], ov, sizeof(int));
+			memcpy(&packed[1], v, sizeof(int));
+
+			o = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(
+				_mm_cvtsi32_si128(packed[0]), zero), zero));
+			n = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(
+				_mm_cvtsi32_si128(packed[1]), zero), zero));
+
+			l = _mm_add_ps(_mm_add_ps(m, _mm_mul_ps(o, b)), _mm_mul_ps(n, f));
+
+			if (shell)
+			{
+				float *normal = r_avertexnormals[verts[i].lightnormalindex];
+
+				l = _mm_add_ps(l, _mm_mul_ps(
+					_mm_setr_ps(normal[0], normal[1], normal[2], 0),
+					_mm_set1_ps(POWERSUIT_SCALE)));
+			}
+
+			_mm_storeu_ps(lerp, l);
+		}
+#endif
+	}
+#else
+	if (shell)
 	{
 		for (i = 0; i < nverts; i++, v++, ov++, lerp += 4)
 		{
@@ -78,6 +161,7 @@ R_LerpVerts(int nverts, dtrivertx_t *v, dtrivertx_t *ov,
 			lerp[2] = move[2] + ov->v[2] * backv[2] + v->v[2] * frontv[2];
 		}
 	}
+#endif
 }
 
 /*
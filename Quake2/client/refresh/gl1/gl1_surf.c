@@ -30,6 +30,7 @@
 
 int c_visible_lightmaps;
 int c_visible_textures;
+int c_world_draws;
 static vec3_t modelorg; /* relative to viewpoint */
 msurface_t *r_alpha_surfaces;
 
@@ -66,6 +67,92 @@ R_TextureAnimation(mtexinfo_t *tex)
 	return tex->image;
 }
 
+/*
+ * Opaque world polygons sharing a texture (or a lightmap page)
+ * are collected into one triangle list and drawn with a single
+ * glDrawElements, instead of one glDrawArrays per polygon. The
+ * batch must be flushed before anything that changes the bound
+ * texture or the texture environment.
+ */
+#define MAX_BATCH_VERTS 4096
+#define MAX_BATCH_INDICES (MAX_BATCH_VERTS * 3)
+
+static GLfloat batch_verts[MAX_BATCH_VERTS * 5];
+static GLushort batch_indices[MAX_BATCH_INDICES];
+static int batch_numverts, batch_numindices;
+
+static void
+R_FlushPolyBatch(void)
+{
+	if (!batch_numindices)
+	{
+		return;
+	}
+
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+
+	glVertexPointer( 3, GL_FLOAT, 5*sizeof(GLfloat), batch_verts );
+	glTexCoordPointer( 2, GL_FLOAT, 5*sizeof(GLfloat), batch_verts+3 );
+	glDrawElements( GL_TRIANGLES, batch_numindices, GL_UNSIGNED_SHORT, batch_indices );
+
+	glDisableClientState( GL_VERTEX_ARRAY );
+	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+
+	c_world_draws++;
+
+	batch_numverts = 0;
+	batch_numindices = 0;
+}
+
+/*
+ * Appends the fan of p as triangles. st selects the texture
+ * coordinates: 3 for the diffuse ones, 5 for the lightmap.
+ */
+static void
+R_BatchGLPoly(glpoly_t *p, int st, float soffset, float toffset)
+{
+	float *v;
+	GLfloat *dst;
+	GLushort *idx;
+	int i;
+
+	if (p->numverts < 3)
+	{
+		return;
+	}
+
+	if ((batch_numverts + p->numverts > MAX_BATCH_VERTS) ||
+		(batch_numindices + (p->numverts - 2) * 3 > MAX_BATCH_INDICES))
+	{
+		R_FlushPolyBatch();
+	}
+
+	v = p->verts[0];
+	dst = batch_verts + batch_numverts * 5;
+
+	for (i = 0; i < p->numverts; i++, v += VERTEXSIZE, dst += 5)
+	{
+		dst[0] = v[0];
+		dst[1] = v[1];
+		dst[2] = v[2];
+		dst[3] = v[st] - soffset;
+		dst[4] = v[st + 1] - toffset;
+	}
+
+	idx = batch_indices + batch_numindices;
+
+	for (i = 2; i < p->numverts; i++)
+	{
+		*idx++ = batch_numverts;
+		*idx++ = batch_numverts + i - 1;
+		*idx++ = batch_numverts + i;
+	}
+
+	batch_numindices += (p->numverts - 2) * 3;
+	batch_numverts += p->numverts;
+}
+
 void
 R_DrawGLPoly(glpoly_t *p)
 {
@@ -182,61 +269,19 @@ R_DrawTriangleOutlines(void)
 void
 R_DrawGLPolyChain(glpoly_t *p, float soffset, float toffset)
 {
-	if ((soffset == 0) && (toffset == 0))
+	for ( ; p != 0; p = p->chain)
 	{
-		for ( ; p != 0; p = p->chain)
-		{
-			float *v;
+		float *v;
 
-			v = p->verts[0];
+		v = p->verts[0];
 
-			if (v == NULL)
-			{
-				fprintf(stderr, "BUGFIX: R_DrawGLPolyChain: v==NULL\n");
-				return;
-			}
-
-            glEnableClientState( GL_VERTEX_ARRAY );
-            glEnableClientState( GL_TEXTURE_COORD_ARRAY );
-
-            glVertexPointer( 3, GL_FLOAT, VERTEXSIZE*sizeof(GLfloat), v );
-            glTexCoordPointer( 2, GL_FLOAT, VERTEXSIZE*sizeof(GLfloat), v+5 );
-            glDrawArrays( GL_TRIANGLE_FAN, 0, p->numverts );
-
-            glDisableClientState( GL_VERTEX_ARRAY );
-            glDisableClientState( GL_TEXTURE_COORD_ARRAY );
-		}
-	}
-	else
-	{
-		for ( ; p != 0; p = p->chain)
+		if (v == NULL)
 		{
-			float *v;
-			int j;
-
-			v = p->verts[0];
-
-            GLfloat tex[2*p->numverts];
-            unsigned int index_tex = 0;
-
-			for ( j = 0; j < p->numverts; j++, v += VERTEXSIZE )
-			{
-			    tex[index_tex++] = v [ 5 ] - soffset;
-			    tex[index_tex++] = v [ 6 ] - toffset;
-			}
-
-			v = p->verts [ 0 ];
-
-            glEnableClientState( GL_VERTEX_ARRAY );
-            glEnableClientState( GL_TEXTURE_COORD_ARRAY );
-
-            glVertexPointer( 3, GL_FLOAT, VERTEXSIZE*sizeof(GLfloat), v );
-            glTexCoordPointer( 2, GL_FLOAT, 0, tex );
-            glDrawArrays( GL_TRIANGLE_FAN, 0, p->numverts );
-
-            glDisableClientState( GL_VERTEX_ARRAY );
-            glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+			fprintf(stderr, "BUGFIX: R_DrawGLPolyChain: v==NULL\n");
+			break;
 		}
+
+		R_BatchGLPoly(p, 5, soffset, toffset);
 	}
 }
 
@@ -297,22 +342,24 @@ R_BlendLightmaps(void)
 
 			R_Bind(gl_state.lightmap_textures + i);
 
+			// Apply overbright bits to the static lightmaps
+			if (gl1_overbrightbits->value)
+			{
+				R_TexEnv(GL_COMBINE_EXT);
+				glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
+			}
+
 			for (surf = gl_lms.lightmap_surfaces[i];
 				 surf != 0;
 				 surf = surf->lightmapchain)
 			{
 				if (surf->polys)
 				{
-					// Apply overbright bits to the static lightmaps
-					if (gl1_overbrightbits->value)
-					{
-						R_TexEnv(GL_COMBINE_EXT);
-						glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
-					}
-
 					R_DrawGLPolyChain(surf->polys, 0, 0);
 				}
 			}
+
+			R_FlushPolyBatch();
 		}
 	}
 
@@ -355,6 +402,13 @@ R_BlendLightmaps(void)
 				/* upload what we have so far */
 				LM_UploadBlock(true);
 
+				// Apply overbright bits to the dynamic lightmaps
+				if (gl1_overbrightbits->value)
+				{
+					R_TexEnv(GL_COMBINE_EXT);
+					glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
+				}
+
 				/* draw all surfaces that use this lightmap */
 				for (drawsurf = newdrawsurf;
 					 drawsurf != surf;
@@ -362,19 +416,15 @@ R_BlendLightmaps(void)
 				{
 					if (drawsurf->polys)
 					{
-						// Apply overbright bits to the dynamic lightmaps
-						if (gl1_overbrightbits->value)
-						{
-							R_TexEnv(GL_COMBINE_EXT);
-							glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
-						}
-
 						R_DrawGLPolyChain(drawsurf->polys,
 								(drawsurf->light_s - drawsurf->dlight_s) * (1.0 / 128.0),
 								(drawsurf->light_t - drawsurf->dlight_t) * (1.0 / 128.0));
 					}
 				}
 
+				/* the block is cleared and refilled next */
+				R_FlushPolyBatch();
+
 				newdrawsurf = drawsurf;
 
 				/* clear the block */
@@ -402,22 +452,24 @@ R_BlendLightmaps(void)
 			LM_UploadBlock(true);
 		}
 
+		// Apply overbright bits to the remainder lightmaps
+		if (newdrawsurf && gl1_overbrightbits->value)
+		{
+			R_TexEnv(GL_COMBINE_EXT);
+			glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
+		}
+
 		for (surf = newdrawsurf; surf != 0; surf = surf->lightmapchain)
 		{
 			if (surf->polys)
 			{
-				// Apply overbright bits to the remainder lightmaps
-				if (gl1_overbrightbits->value)
-				{
-					R_TexEnv(GL_COMBINE_EXT);
-					glTexEnvi(GL_TEXTURE_ENV, GL_RGB_SCALE_EXT, gl1_overbrightbits->value);
-				}
-
 				R_DrawGLPolyChain(surf->polys,
 						(surf->light_s - surf->dlight_s) * (1.0 / 128.0),
 						(surf->light_t - surf->dlight_t) * (1.0 / 128.0));
 			}
 		}
+
+		R_FlushPolyBatch();
 	}
 
 	/* restore state */
@@ -437,8 +489,15 @@ R_RenderBrushPoly(msurface_t *fa)
 
 	image = R_TextureAnimation(fa->texinfo);
 
+	/* the pending batch belongs to the bound texture */
+	if (image->texnum != gl_state.currenttextures[gl_state.currenttmu])
+	{
+		R_FlushPolyBatch();
+	}
+
 	if (fa->flags & SURF_DRAWTURB)
 	{
+		R_FlushPolyBatch();
 		R_Bind(image->texnum);
 
 		/* This is a hack ontop of a hack. Warping surfaces like those generated
@@ -484,7 +543,7 @@ R_RenderBrushPoly(msurface_t *fa)
 	}
 	else
 	{
-		R_DrawGLPoly(fa->polys);
+		R_BatchGLPoly(fa->polys, 3, 0, 0);
 	}
 
 	/* check for lightmap modification */
@@ -529,6 +588,7 @@ R_RenderBrushPoly(msurface_t *fa)
 			R_BuildLightMap(fa, (void *)temp, smax * 4);
 			R_SetCacheState(fa);
 
+			R_FlushPolyBatch();
 			R_Bind(gl_state.lightmap_textures + fa->lightmaptexturenum);
 
 			glTexSubImage2D(GL_TEXTURE_2D, 0, fa->light_s, fa->light_t,
@@ -640,6 +700,8 @@ R_DrawTextureChains(void)
 			R_RenderBrushPoly(s);
 		}
 
+		R_FlushPolyBatch();
+
 		image->texturechain = NULL;
 	}
 
@@ -700,6 +762,8 @@ R_DrawInlineBModel(void)
 		}
 	}
 
+	R_FlushPolyBatch();
+
 	if (!(currententity->flags & RF_TRANSLUCENT))
 	{
 
@@ -234,6 +234,7 @@ extern int gl_tex_alpha_format;
 
 extern int c_visible_lightmaps;
 extern int c_visible_textures;
+extern int c_world_draws;
 
 extern float r_world_matrix[16];
 
@@ -68,9 +68,21 @@ int gl3_visframecount; /* bumped when going to a new PVS */
 int gl3_framecount; /* used for dlight push checking */
 
 int c_brush_polys, c_alias_polys;
+int c_draw_calls, c_buffer_uploads;
 
 static float v_blend[4]; /* final blending color */
 
+typedef struct part_vtx {
+	GLfloat pos[3];
+	GLfloat size;
+	GLfloat dist;
+	GLfloat color[4];
+} part_vtx;
+
+DA_TYPEDEF(part_vtx, PartVtxArray_t);
+// grown on demand, the particle count is set by the client's cl_maxparticles
+static PartVtxArray_t partBuf = {0};
+
 int gl3_viewcluster, gl3_viewcluster2, gl3_oldviewcluster, gl3_oldviewcluster2;
 
 const hmm_mat4 gl3_identityMat4 = {{
@@ -578,6 +590,7 @@ GL3_Shutdown(void)
 	{
 		GL3_Mod_FreeAll();
 		GL3_ShutdownMeshes();
+		da_free(partBuf);
 		GL3_ShutdownImages();
 		GL3_SurfShutdown();
 		GL3_Draw_ShutdownLocal();
@@ -815,15 +828,12 @@ GL3_DrawParticles(void)
 		// assume the size looks good with window height 480px and scale according to real resolution
 		float pointSize = gl3_particle_size->value * (float)gl3_newrefdef.height/480.0f;
 
-		typedef struct part_vtx {
-			GLfloat pos[3];
-			GLfloat size;
-			GLfloat dist;
-			GLfloat color[4];
-		} part_vtx;
 		assert(sizeof(part_vtx)==9*sizeof(float)); // remember to update GL3_SurfInit() if this changes!
 
-		part_vtx buf[numParticles];
+		part_vtx* buf;
+
+		da_clear(partBuf);
+		buf = da_addn_uninit(partBuf, numParticles);
 
 		// TODO: viewOrg could be in UBO
 		vec3_t viewOrg;
@@ -1408,6 +1418,8 @@ GL3_RenderView(refdef_t *fd)
 	{
 		c_brush_polys = 0;
 		c_alias_polys = 0;
+		c_draw_calls = 0;
+		c_buffer_uploads = 0;
 	}
 
 	GL3_PushDlights();
@@ -1440,9 +1452,9 @@ GL3_RenderView(refdef_t *fd)
 
 	if (r_speeds->value)
 	{
-		R_Printf(PRINT_ALL, "%4i wpoly %4i epoly %i tex %i lmaps\n",
+		R_Printf(PRINT_ALL, "%4i wpoly %4i epoly %i tex %i lmaps %i draws %i uploads\n",
 				c_brush_polys, c_alias_polys, c_visible_textures,
-				c_visible_lightmaps);
+				c_visible_lightmaps, c_draw_calls, c_buffer_uploads);
 	}
 
 #if 0 // TODO: stereo stuff
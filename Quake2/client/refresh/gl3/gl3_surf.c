@@ -29,6 +29,8 @@
 
 #include "header/local.h"
 
+#include "header/DG_dynarr.h"
+
 int c_visible_lightmaps;
 int c_visible_textures;
 static vec3_t modelorg; /* relative to viewpoint */
@@ -41,6 +43,22 @@ gl3lightmapstate_t gl3_lms;
 extern gl3image_t gl3textures[MAX_GL3TEXTURES];
 extern int numgl3textures;
 
+DA_TYPEDEF(gl3_3D_vtx_t, WorldVtxArray_t);
+DA_TYPEDEF(GLushort, WorldIdxArray_t);
+// lightmapped world polys sharing texture, lightmap, shader and lightstyle
+// scales are collected here and drawn as GL_TRIANGLES in one draw call,
+// instead of one glBufferData() + glDrawArrays() per triangle fan
+static WorldVtxArray_t worldVtxBuf = {0};
+static WorldIdxArray_t worldIdxBuf = {0};
+
+static struct
+{
+	GLuint texnum;
+	int lightmap;
+	gl3ShaderInfo_t* si;
+	hmm_vec4 lmScales[MAX_LIGHTMAPS_PER_SURFACE];
+} worldBatch;
+
 void GL3_SurfInit(void)
 {
 	// init the VAO and VBO for the standard vertexdata: 10 floats and 1 uint
@@ -52,6 +70,10 @@ void GL3_SurfInit(void)
 	glGenBuffers(1, &gl3state.vbo3D);
 	GL3_BindVBO(gl3state.vbo3D);
 
+	// the element buffer binding is part of the VAO state, so vao3D keeps this one
+	glGenBuffers(1, &gl3state.ebo3D);
+	GL3_BindEBO(gl3state.ebo3D);
+
 	glEnableVertexAttribArray(GL3_ATTRIB_POSITION);
 	qglVertexAttribPointer(GL3_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(gl3_3D_vtx_t), 0);
 
@@ -111,6 +133,8 @@ void GL3_SurfInit(void)
 
 void GL3_SurfShutdown(void)
 {
+	glDeleteBuffers(1, &gl3state.ebo3D);
+	gl3state.ebo3D = 0;
 	glDeleteBuffers(1, &gl3state.vbo3D);
 	gl3state.vbo3D = 0;
 	glDeleteVertexArrays(1, &gl3state.vao3D);
@@ -122,6 +146,9 @@ void GL3_SurfShutdown(void)
 	gl3state.vboAlias = 0;
 	glDeleteVertexArrays(1, &gl3state.vaoAlias);
 	gl3state.vaoAlias = 0;
+
+	da_free(worldVtxBuf);
+	da_free(worldIdxBuf);
 }
 
 /*
@@ -215,16 +242,16 @@ GL3_DrawGLPoly(msurface_t *fa)
 	glBufferData(GL_ARRAY_BUFFER, sizeof(gl3_3D_vtx_t)*p->numverts, p->vertices, GL_STREAM_DRAW);
 
 	glDrawArrays(GL_TRIANGLE_FAN, 0, p->numverts);
+
+	c_buffer_uploads++;
+	c_draw_calls++;
 }
 
-void
-GL3_DrawGLFlowingPoly(msurface_t *fa)
+static void
+UpdateFlowScroll(void)
 {
-	glpoly_t *p;
 	float scroll;
 
-	p = fa->polys;
-
 	scroll = -64.0f * ((gl3_newrefdef.time / 40.0f) - (int)(gl3_newrefdef.time / 40.0f));
 
 	if (scroll == 0.0f)
@@ -237,12 +264,50 @@ GL3_DrawGLFlowingPoly(msurface_t *fa)
 		gl3state.uni3DData.scroll = scroll;
 		GL3_UpdateUBO3D();
 	}
+}
+
+void
+GL3_DrawGLFlowingPoly(msurface_t *fa)
+{
+	glpoly_t *p = fa->polys;
+
+	UpdateFlowScroll();
 
 	GL3_BindVAO(gl3state.vao3D);
 	GL3_BindVBO(gl3state.vbo3D);
 
 	glBufferData(GL_ARRAY_BUFFER, sizeof(gl3_3D_vtx_t)*p->numverts, p->vertices, GL_STREAM_DRAW);
 	glDrawArrays(GL_TRIANGLE_FAN, 0, p->numverts);
+
+	c_buffer_uploads++;
+	c_draw_calls++;
+}
+
+/*
+ * Draws the pending batch of lightmapped world polys, if any.
+ * Must be called before anything changes the state the batch was
+ * started with (bound textures, shader, lightmap scales, UBOs, blending).
+ */
+static void
+FlushWorldBatch(void)
+{
+	if (da_count(worldIdxBuf) == 0)
+	{
+		return;
+	}
+
+	GL3_BindVAO(gl3state.vao3D);
+	GL3_BindVBO(gl3state.vbo3D);
+	glBufferData(GL_ARRAY_BUFFER, da_count(worldVtxBuf)*sizeof(gl3_3D_vtx_t), worldVtxBuf.p, GL_STREAM_DRAW);
+	GL3_BindEBO(gl3state.ebo3D);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, da_count(worldIdxBuf)*sizeof(GLushort), worldIdxBuf.p, GL_STREAM_DRAW);
+	glDrawElements(GL_TRIANGLES, da_count(worldIdxBuf), GL_UNSIGNED_SHORT, NULL);
+
+	c_buffer_uploads += 2;
+	c_draw_calls++;
+
+	da_clear(worldVtxBuf);
+	da_clear(worldIdxBuf);
 }
 
 static void
@@ -331,6 +396,68 @@ UpdateLMscales(const hmm_vec4 lmScales[MAX_LIGHTMAPS_PER_SURFACE], gl3ShaderInfo
 	}
 }
 
+/*
+ * Appends the polygon of a lightmapped surface to the current world batch,
+ * flushing the batch first if it was started with different state.
+ */
+static void
+BatchLightmappedPoly(msurface_t *surf, gl3image_t *image, const hmm_vec4 lmScales[MAX_LIGHTMAPS_PER_SURFACE])
+{
+	glpoly_t *p = surf->polys;
+	int numVerts = p->numverts;
+	gl3ShaderInfo_t* si = (surf->texinfo->flags & SURF_FLOWING) ? &gl3state.si3DlmFlow : &gl3state.si3Dlm;
+	GLushort firstVtx;
+	gl3_3D_vtx_t *vtx;
+	GLushort *idx;
+	int i;
+
+	if (da_count(worldIdxBuf) != 0)
+	{
+		if (   image->texnum != worldBatch.texnum
+		    || surf->lightmaptexturenum != worldBatch.lightmap
+		    || si != worldBatch.si
+		    || memcmp(lmScales, worldBatch.lmScales, sizeof(worldBatch.lmScales)) != 0
+		    || da_count(worldVtxBuf) + numVerts > 0xFFFF )
+		{
+			FlushWorldBatch();
+		}
+	}
+
+	if (da_count(worldIdxBuf) == 0)
+	{
+		// new batch: set up the state it will be drawn with
+		worldBatch.texnum = image->texnum;
+		worldBatch.lightmap = surf->lightmaptexturenum;
+		worldBatch.si = si;
+		memcpy(worldBatch.lmScales, lmScales, sizeof(worldBatch.lmScales));
+
+		GL3_Bind(image->texnum);
+		GL3_BindLightmap(surf->lightmaptexturenum);
+
+		if (si == &gl3state.si3DlmFlow)
+		{
+			UpdateFlowScroll();
+		}
+
+		GL3_UseProgram(si->shaderProgram);
+		UpdateLMscales(lmScales, si);
+	}
+
+	// the polygon is a triangle fan, turn it into triangles
+	firstVtx = da_count(worldVtxBuf);
+	vtx = da_addn_uninit(worldVtxBuf, numVerts);
+	memcpy(vtx, p->vertices, numVerts*sizeof(gl3_3D_vtx_t));
+
+	idx = da_addn_uninit(worldIdxBuf, 3*(numVerts-2));
+	for (i = 1; i < numVerts-1; ++i)
+	{
+		idx[0] = firstVtx;
+		idx[1] = firstVtx + i;
+		idx[2] = firstVtx + i + 1;
+		idx += 3;
+	}
+}
+
 static void
 RenderBrushPoly(msurface_t *fa)
 {
@@ -343,22 +470,18 @@ RenderBrushPoly(msurface_t *fa)
 
 	if (fa->flags & SURF_DRAWTURB)
 	{
+		FlushWorldBatch();
+
 		GL3_Bind(image->texnum);
 
 		GL3_EmitWaterPolys(fa);
 
 		return;
 	}
-	else
-	{
-		GL3_Bind(image->texnum);
-	}
 
 	hmm_vec4 lmScales[MAX_LIGHTMAPS_PER_SURFACE] = {0};
 	lmScales[0] = HMM_Vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
-	GL3_BindLightmap(fa->lightmaptexturenum);
-
 	// Any dynamic lights on this surface?
 	for (map = 0; map < MAX_LIGHTMAPS_PER_SURFACE && fa->styles[map] != 255; map++)
 	{
@@ -368,18 +491,7 @@ RenderBrushPoly(msurface_t *fa)
 		lmScales[map].A = 1.0f;
 	}
 
-	if (fa->texinfo->flags & SURF_FLOWING)
-	{
-		GL3_UseProgram(gl3state.si3DlmFlow.shaderProgram);
-		UpdateLMscales(lmScales, &gl3state.si3DlmFlow);
-		GL3_DrawGLFlowingPoly(fa);
-	}
-	else
-	{
-		GL3_UseProgram(gl3state.si3Dlm.shaderProgram);
-		UpdateLMscales(lmScales, &gl3state.si3Dlm);
-		GL3_DrawGLPoly(fa);
-	}
+	BatchLightmappedPoly(fa, image, lmScales);
 
 	// Note: lightmap chains are gone, lightmaps are rendered together with normal texture in one pass
 }
@@ -477,6 +589,8 @@ DrawTextureChains(void)
 		image->texturechain = NULL;
 	}
 
+	FlushWorldBatch();
+
 	// TODO: maybe one loop for normal faces and one for SURF_DRAWTURB ???
 }
 
@@ -503,21 +617,7 @@ RenderLightmappedPoly(msurface_t *surf)
 
 	c_brush_polys++;
 
-	GL3_Bind(image->texnum);
-	GL3_BindLightmap(surf->lightmaptexturenum);
-
-	if (surf->texinfo->flags & SURF_FLOWING)
-	{
-		GL3_UseProgram(gl3state.si3DlmFlow.shaderProgram);
-		UpdateLMscales(lmScales, &gl3state.si3DlmFlow);
-		GL3_DrawGLFlowingPoly(surf);
-	}
-	else
-	{
-		GL3_UseProgram(gl3state.si3Dlm.shaderProgram);
-		UpdateLMscales(lmScales, &gl3state.si3Dlm);
-		GL3_DrawGLPoly(surf);
-	}
+	BatchLightmappedPoly(surf, image, lmScales);
 }
 
 static void
@@ -578,6 +678,8 @@ DrawInlineBModel(void)
 		}
 	}
 
+	FlushWorldBatch();
+
 	if (currententity->flags & RF_TRANSLUCENT)
 	{
 		glDisable(GL_BLEND);
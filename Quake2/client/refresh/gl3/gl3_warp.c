@@ -258,6 +258,9 @@ GL3_EmitWaterPolys(msurface_t *fa)
 		int numverts = bp->numverts;
 		glBufferData(GL_ARRAY_BUFFER, sizeof(gl3_3D_vtx_t)*numverts, bp->vertices, GL_STREAM_DRAW);
 		glDrawArrays(GL_TRIANGLE_FAN, 0, numverts);
+
+		c_buffer_uploads++;
+		c_draw_calls++;
 	}
 }
 
@@ -728,6 +731,9 @@ GL3_DrawSkyBox(void)
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(skyVertices), skyVertices, GL_STREAM_DRAW);
 		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+
+		c_buffer_uploads++;
+		c_draw_calls++;
 	}
 
 	// glPopMatrix();
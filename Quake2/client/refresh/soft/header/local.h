@@ -31,6 +31,17 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include <string.h>
 #include <stdarg.h>
 
+/* Span, z and lightmap loops have vector paths for
+   NEON (iOS and tvOS devices) and SSE2 (x86_64);
+   elsewhere the C loops are used. */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SW_SIMD_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define SW_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 #define REF_VERSION	"SOFT 0.01"
 
 // up / down
@@ -167,6 +178,7 @@ extern oldrefdef_t	r_refdef;
 #define ALIAS_XY_CLIP_MASK	0x000F
 
 #define SURFCACHE_SIZE_AT_320X240	1024*768
+#define SURFCACHE_SIZE_MAX		32*1024*1024
 
 #define BMODEL_FULLY_CLIPPED	0x10 // value returned by R_BmodelCheckBBox ()
 				     //  if bbox is trivially rejected
@@ -264,6 +276,7 @@ typedef struct surfcache_s
 	struct surfcache_s	**owner; // NULL is an empty chunk of memory
 	int			lightadj[MAXLIGHTMAPS]; // checked for strobe flush
 	int			dlight;
+	int			lastframe; // r_framecount of the last draw
 	int			size; // including header
 	unsigned		width;
 	unsigned		height; // DEBUG only needed for debug
@@ -346,6 +359,8 @@ extern qboolean	r_dowarp;
 extern affinetridesc_t	r_affinetridesc;
 
 void D_WarpScreen(void);
+void D_InvalidateCoarseZ(void);
+qboolean D_RectOccluded(int u0, int v0, int u1, int v1, zvalue_t izi);
 void R_PolysetUpdateTables(void);
 
 //=======================================================================//
@@ -353,6 +368,7 @@ void R_PolysetUpdateTables(void);
 // callbacks to Quake
 
 extern int		c_surf;
+extern int		c_surfhits, c_surfbuilt, c_surfthrash;
 
 extern pixel_t		*r_warpbuffer;
 
@@ -489,6 +505,8 @@ extern int	r_currentbkey;
 void R_DrawParticles (void);
 
 extern int	r_amodels_drawn;
+extern int	r_amodels_occluded;
+extern cvar_t	*sw_occlusion;
 extern int	r_numallocatededges;
 extern edge_t	*r_edges, *edge_p, *edge_max;
 
@@ -509,6 +527,10 @@ void R_PolysetDrawSpans8_Opaque(const entity_t *currententity, spanpackage_t *ps
 
 extern byte	**warp_rowptr;
 extern int	*warp_column;
+
+#define COARSEZ_SHIFT	4
+#define COARSEZ_SIZE	(1 << COARSEZ_SHIFT)
+extern zvalue_t	*d_coarsez;
 extern espan_t	*edge_basespans;
 extern int	r_numallocatedverts;
 extern finalvert_t	*finalverts, *finalverts_max;
@@ -542,6 +564,9 @@ extern model_t		 *r_worldmodel;
 void R_PrintAliasStats (void);
 void R_PrintTimes (void);
 void R_PrintDSpeeds (void);
+
+typedef void (*bandfunc_t)(void *data, int y0, int y1);
+void R_RunBands (bandfunc_t func, void *data, int height);
 void R_LightPoint (const entity_t *currententity, vec3_t p, vec3_t color);
 void R_SetupFrame (void);
 
@@ -557,6 +582,7 @@ void R_NewMap (void);
 void Draw_InitLocal(void);
 void R_InitCaches(void);
 void D_FlushCaches(void);
+void D_GrowCaches(void);
 
 void	RE_BeginRegistration (char *map);
 struct model_s  *RE_RegisterModel (char *name);
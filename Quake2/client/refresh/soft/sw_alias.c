@@ -29,6 +29,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 				//  need for inner-loop light clamping
 
 int				r_amodels_drawn;
+int				r_amodels_occluded;
 
 affinetridesc_t	r_affinetridesc;
 
@@ -213,6 +214,101 @@ R_AliasTransformVector(const vec3_t in, vec3_t out, const float xf[3][4] )
 	out[2] = DotProduct(in, xf[2]) + xf[2][3];
 }
 
+/*
+================
+R_AliasOccluded
+
+Projects the frame bounding box (both of them when lerping, the model
+is drawn somewhere in between, grown by POWERSUIT_SCALE for shells) and
+asks the coarse z buffer whether all of it lies behind what has already
+been drawn.
+================
+*/
+static qboolean
+R_AliasOccluded (const entity_t *currententity)
+{
+	vec3_t	delta, viewdelta;
+	float	umin, umax, vmin, vmax, zmin;
+	float	grow;
+	int	f, i;
+
+	if (!sw_occlusion->value || !r_drawworld->value ||
+		(r_newrefdef.rdflags & RDF_NOWORLDMODEL))
+		return false;
+
+	if (currententity->flags & (RF_WEAPONMODEL | RF_DEPTHHACK))
+		return false;
+
+	// shells push every vertex out along its normal
+	grow = 0;
+	if (currententity->flags & ( RF_SHELL_RED | RF_SHELL_GREEN | RF_SHELL_BLUE | RF_SHELL_DOUBLE | RF_SHELL_HALF_DAM))
+		grow = POWERSUIT_SCALE;
+
+	// the old frame sits at oldorigin, shifted in view space
+	VectorSubtract (currententity->oldorigin, currententity->origin, delta);
+	viewdelta[0] = DotProduct (delta, vright);
+	viewdelta[1] = -DotProduct (delta, vup);
+	viewdelta[2] = DotProduct (delta, vpn);
+
+	umin = vmin = zmin = 999999;
+	umax = vmax = -999999;
+
+	for (f = 0; f < 2; f++)
+	{
+		const daliasframe_t	*frame;
+		vec3_t	mins, maxs;
+
+		if (f && currententity->backlerp == 0)
+			break;
+
+		frame = f ? r_lastframe : r_thisframe;
+
+		for (i = 0; i < 3; i++)
+		{
+			mins[i] = frame->translate[i] - grow;
+			maxs[i] = frame->translate[i] + frame->scale[i]*255 + grow;
+		}
+
+		for (i = 0; i < 8; i++)
+		{
+			vec3_t	tmp, v;
+			float	zi, u, y;
+
+			tmp[0] = (i & 1) ? mins[0] : maxs[0];
+			tmp[1] = (i & 2) ? mins[1] : maxs[1];
+			tmp[2] = (i & 4) ? mins[2] : maxs[2];
+
+			R_AliasTransformVector (tmp, v, aliastransform);
+			if (f)
+				VectorAdd (v, viewdelta, v);
+
+			// crossing the near plane, leave it to the clipper
+			if (v[2] < ALIAS_Z_CLIP_PLANE)
+				return false;
+
+			zi = 1.0 / v[2];
+			u = (v[0] * aliasxscale * zi) + aliasxcenter;
+			y = (v[1] * aliasyscale * zi) + aliasycenter;
+
+			if (u < umin)
+				umin = u;
+			if (u > umax)
+				umax = u;
+			if (y < vmin)
+				vmin = y;
+			if (y > vmax)
+				vmax = y;
+			if (v[2] < zmin)
+				zmin = v[2];
+		}
+	}
+
+	// one pixel and one z step of slack for rounding
+	return D_RectOccluded ((int)umin - 1, (int)vmin - 1,
+			       (int)umax + 1, (int)vmax + 1,
+			       (zvalue_t)(0x8000 / zmin) + 1);
+}
+
 
 /*
 ================
@@ -389,50 +485,167 @@ R_AliasTransformFinalVerts
 static void
 R_AliasTransformFinalVerts(const entity_t *currententity, int numpoints, finalvert_t *fv, dtrivertx_t *oldv, dtrivertx_t *newv )
 {
-	int i;
+	int		i;
+	int		normallight[NUMVERTEXNORMALS];
+	qboolean	shell;
+#if defined(SW_SIMD_NEON)
+	float32x4_t	vmove, vback, vfront, col0, col1, col2, col3;
+#elif defined(SW_SIMD_SSE2)
+	__m128	vmove, vback, vfront, col0, col1, col2, col3;
+#endif
+
+	// a vertex is lit by its normal alone, so shade the normals once
+	// for the model instead of once per vertex
+	for (i = 0; i < NUMVERTEXNORMALS; i++)
+	{
+		int	temp;
+		float	lightcos;
+
+		lightcos = DotProduct (r_avertexnormals[i], r_plightvec);
+		temp = r_ambientlight;
+
+		if (lightcos < 0)
+		{
+			temp += (int)(r_shadelight * lightcos);
+
+			// clamp; because we limited the minimum ambient and shading light, we
+			// don't have to clamp low light, just bright
+			if (temp < 0)
+				temp = 0;
+		}
+
+		normallight[i] = temp;
+	}
+
+	// PMM - added double damage shell
+	shell = (currententity->flags & ( RF_SHELL_RED | RF_SHELL_GREEN | RF_SHELL_BLUE | RF_SHELL_DOUBLE | RF_SHELL_HALF_DAM)) != 0;
+
+	// the transform as columns, so one vertex goes through it with
+	// the same multiply and add order as the DotProducts
+#if defined(SW_SIMD_NEON)
+	{
+		const float	move[4] = {r_lerp_move[0], r_lerp_move[1], r_lerp_move[2], 0};
+		const float	back[4] = {r_lerp_backv[0], r_lerp_backv[1], r_lerp_backv[2], 0};
+		const float	front[4] = {r_lerp_frontv[0], r_lerp_frontv[1], r_lerp_frontv[2], 0};
+		const float	c0[4] = {aliastransform[0][0], aliastransform[1][0], aliastransform[2][0], 0};
+		const float	c1[4] = {aliastransform[0][1], aliastransform[1][1], aliastransform[2][1], 0};
+		const float	c2[4] = {aliastransform[0][2], aliastransform[1][2], aliastransform[2][2], 0};
+		const float	c3[4] = {aliastransform[0][3], aliastransform[1][3], aliastransform[2][3], 0};
+
+		vmove = vld1q_f32(move);
+		vback = vld1q_f32(back);
+		vfront = vld1q_f32(front);
+		col0 = vld1q_f32(c0);
+		col1 = vld1q_f32(c1);
+		col2 = vld1q_f32(c2);
+		col3 = vld1q_f32(c3);
+	}
+#elif defined(SW_SIMD_SSE2)
+	vmove = _mm_setr_ps(r_lerp_move[0], r_lerp_move[1], r_lerp_move[2], 0);
+	vback = _mm_setr_ps(r_lerp_backv[0], r_lerp_backv[1], r_lerp_backv[2], 0);
+	vfront = _mm_setr_ps(r_lerp_frontv[0], r_lerp_frontv[1], r_lerp_frontv[2], 0);
+	col0 = _mm_setr_ps(aliastransform[0][0], aliastransform[1][0], aliastransform[2][0], 0);
+	col1 = _mm_setr_ps(aliastransform[0][1], aliastransform[1][1], aliastransform[2][1], 0);
+	col2 = _mm_setr_ps(aliastransform[0][2], aliastransform[1][2], aliastransform[2][2], 0);
+	col3 = _mm_setr_ps(aliastransform[0][3], aliastransform[1][3], aliastransform[2][3], 0);
+#endif
 
 	for ( i = 0; i < numpoints; i++, fv++, oldv++, newv++ )
 	{
-		int		temp;
-		float	lightcos;
 		const float	*plightnormal;
-		vec3_t  lerped_vert;
-
-		lerped_vert[0] = r_lerp_move[0] + oldv->v[0]*r_lerp_backv[0] + newv->v[0]*r_lerp_frontv[0];
-		lerped_vert[1] = r_lerp_move[1] + oldv->v[1]*r_lerp_backv[1] + newv->v[1]*r_lerp_frontv[1];
-		lerped_vert[2] = r_lerp_move[2] + oldv->v[2]*r_lerp_backv[2] + newv->v[2]*r_lerp_frontv[2];
 
 		plightnormal = r_avertexnormals[newv->lightnormalindex];
 
-		// PMM - added double damage shell
-		if ( currententity->flags & ( RF_SHELL_RED | RF_SHELL_GREEN | RF_SHELL_BLUE | RF_SHELL_DOUBLE | RF_SHELL_HALF_DAM) )
+#if defined(SW_SIMD_NEON)
 		{
-			lerped_vert[0] += plightnormal[0] * POWERSUIT_SCALE;
-			lerped_vert[1] += plightnormal[1] * POWERSUIT_SCALE;
-			lerped_vert[2] += plightnormal[2] * POWERSUIT_SCALE;
+			float32x4_t	o, n, l, xyz;
+			float	out[4];
+
+			o = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(
+				vreinterpret_u8_u32(vld1_dup_u32((const uint32_t *)oldv))))));
+			n = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(
+				vreinterpret_u8_u32(vld1_dup_u32((const uint32_t *)newv))))));
+
+			l = vaddq_f32(vaddq_f32(vmove, vmulq_f32(o, vback)), vmulq_f32(n, vfront));
+
+			if (shell)
+			{
+				const float	pn[4] = {plightnormal[0], plightnormal[1], plightnormal[2], 0};
+
+				l = vaddq_f32(l, vmulq_n_f32(vld1q_f32(pn), POWERSUIT_SCALE));
+			}
+
+			xyz = vaddq_f32(vmulq_n_f32(col0, vgetq_lane_f32(l, 0)),
+					vmulq_n_f32(col1, vgetq_lane_f32(l, 1)));
+			xyz = vaddq_f32(xyz, vmulq_n_f32(col2, vgetq_lane_f32(l, 2)));
+			xyz = vaddq_f32(xyz, col3);
+
+			vst1q_f32(out, xyz);
+			fv->xyz[0] = out[0];
+			fv->xyz[1] = out[1];
+			fv->xyz[2] = out[2];
 		}
+#elif defined(SW_SIMD_SSE2)
+		{
+			__m128	o, n, l, xyz;
+			__m128i	zero = _mm_setzero_si128();
+			float	out[4];
+			int	packed[2];
 
-		fv->xyz[0] = DotProduct(lerped_vert, aliastransform[0]) + aliastransform[0][3];
-		fv->xyz[1] = DotProduct(lerped_vert, aliastransform[1]) + aliastransform[1][3];
-		fv->xyz[2] = DotProduct(lerped_vert, aliastransform[2]) + aliastransform[2][3];
+			memcpy(&packed[0], oldv, sizeof(int));
+			memcpy(&packed[1], newv, sizeof(int));
 
-		fv->flags = 0;
+			o = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(
+				_mm_cvtsi32_si128(packed[0]), zero), zero));
+			n = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(
+				_mm_cvtsi32_si128(packed[1]), zero), zero));
 
-		// lighting
-		lightcos = DotProduct (plightnormal, r_plightvec);
-		temp = r_ambientlight;
+			l = _mm_add_ps(_mm_add_ps(vmove, _mm_mul_ps(o, vback)), _mm_mul_ps(n, vfront));
 
-		if (lightcos < 0)
+			if (shell)
+			{
+				l = _mm_add_ps(l, _mm_mul_ps(
+					_mm_setr_ps(plightnormal[0], plightnormal[1], plightnormal[2], 0),
+					_mm_set1_ps(POWERSUIT_SCALE)));
+			}
+
+			xyz = _mm_add_ps(
+				_mm_mul_ps(col0, _mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0))),
+				_mm_mul_ps(col1, _mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1))));
+			xyz = _mm_add_ps(xyz,
+				_mm_mul_ps(col2, _mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2))));
+			xyz = _mm_add_ps(xyz, col3);
+
+			_mm_storeu_ps(out, xyz);
+			fv->xyz[0] = out[0];
+			fv->xyz[1] = out[1];
+			fv->xyz[2] = out[2];
+		}
+#else
 		{
-			temp += (int)(r_shadelight * lightcos);
+			vec3_t  lerped_vert;
 
-			// clamp; because we limited the minimum ambient and shading light, we
-			// don't have to clamp low light, just bright
-			if (temp < 0)
-				temp = 0;
+			lerped_vert[0] = r_lerp_move[0] + oldv->v[0]*r_lerp_backv[0] + newv->v[0]*r_lerp_frontv[0];
+			lerped_vert[1] = r_lerp_move[1] + oldv->v[1]*r_lerp_backv[1] + newv->v[1]*r_lerp_frontv[1];
+			lerped_vert[2] = r_lerp_move[2] + oldv->v[2]*r_lerp_backv[2] + newv->v[2]*r_lerp_frontv[2];
+
+			if (shell)
+			{
+				lerped_vert[0] += plightnormal[0] * POWERSUIT_SCALE;
+				lerped_vert[1] += plightnormal[1] * POWERSUIT_SCALE;
+				lerped_vert[2] += plightnormal[2] * POWERSUIT_SCALE;
+			}
+
+			fv->xyz[0] = DotProduct(lerped_vert, aliastransform[0]) + aliastransform[0][3];
+			fv->xyz[1] = DotProduct(lerped_vert, aliastransform[1]) + aliastransform[1][3];
+			fv->xyz[2] = DotProduct(lerped_vert, aliastransform[2]) + aliastransform[2][3];
 		}
+#endif
+
+		fv->flags = 0;
 
-		fv->l = temp;
+		// lighting
+		fv->l = normallight[newv->lightnormalindex];
 
 		if ( fv->xyz[2] < ALIAS_Z_CLIP_PLANE )
 		{
@@ -746,6 +959,13 @@ R_AliasDrawModel(entity_t *currententity, const model_t *currentmodel)
 		return;
 	}
 
+	// hidden behind the world drawn so far
+	if ( R_AliasOccluded(currententity) )
+	{
+		r_amodels_occluded++;
+		return;
+	}
+
 	// set up the skin and verify it exists
 	if ( !R_AliasSetupSkin(currententity, currentmodel) )
 	{
@@ -290,15 +290,18 @@ R_AddDynamicLights (drawsurf_t* drawsurf)
 	mtexinfo_t	*tex;
 	dlight_t	*dl;
 	int		negativeLight;	//PGM
+	unsigned	bits;
 
 	surf = drawsurf->surf;
 	smax = (surf->extents[0]>>4)+1;
 	tmax = (surf->extents[1]>>4)+1;
 	tex = surf->texinfo;
 
-	for (lnum=0 ; lnum<r_newrefdef.num_dlights ; lnum++)
+	// walk the marked lights only, stop after the last one
+	bits = surf->dlightbits;
+	for (lnum=0 ; bits ; lnum++, bits >>= 1)
 	{
-		if (!(surf->dlightbits & (1<<lnum)))
+		if (!(bits & 1))
 			continue;	// not lit by this light
 
 		dl = &r_newrefdef.dlights[lnum];
@@ -371,6 +374,149 @@ R_AddDynamicLights (drawsurf_t* drawsurf)
 	}
 }
 
+/*
+===============
+R_AccumulateLightmap
+
+blocklights[i] (+)= lightmap[i] * scale over size samples; the first
+map stores instead of adding so the block needs no separate clear
+===============
+*/
+static void
+R_AccumulateLightmap (const byte *lightmap, unsigned scale, int size, qboolean first)
+{
+	unsigned	*dest = blocklights;
+	int		i = 0;
+
+#if defined(SW_SIMD_NEON)
+	if (scale <= 0xffff)
+	{
+		uint16x4_t	vscale = vdup_n_u16(scale);
+
+		for (; i + 8 <= size; i += 8)
+		{
+			uint16x8_t	l = vmovl_u8(vld1_u8(lightmap + i));
+			uint32x4_t	lo, hi;
+
+			if (first)
+			{
+				lo = vmull_u16(vget_low_u16(l), vscale);
+				hi = vmull_u16(vget_high_u16(l), vscale);
+			}
+			else
+			{
+				lo = vmlal_u16(vld1q_u32(dest + i), vget_low_u16(l), vscale);
+				hi = vmlal_u16(vld1q_u32(dest + i + 4), vget_high_u16(l), vscale);
+			}
+
+			vst1q_u32(dest + i, lo);
+			vst1q_u32(dest + i + 4, hi);
+		}
+	}
+#elif defined(SW_SIMD_SSE2)
+	if (scale <= 0xffff)
+	{
+		__m128i	vscale = _mm_set1_epi16((short)scale);
+		__m128i	zero = _mm_setzero_si128();
+
+		for (; i + 8 <= size; i += 8)
+		{
+			__m128i	l, plo, phi, lo, hi;
+
+			l = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(lightmap + i)), zero);
+			plo = _mm_mullo_epi16(l, vscale);
+			phi = _mm_mulhi_epu16(l, vscale);
+			lo = _mm_unpacklo_epi16(plo, phi);
+			hi = _mm_unpackhi_epi16(plo, phi);
+
+			if (!first)
+			{
+				lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i *)(dest + i)));
+				hi = _mm_add_epi32(hi, _mm_loadu_si128((const __m128i *)(dest + i + 4)));
+			}
+
+			_mm_storeu_si128((__m128i *)(dest + i), lo);
+			_mm_storeu_si128((__m128i *)(dest + i + 4), hi);
+		}
+	}
+#endif
+
+	if (first)
+	{
+		for (; i < size; i++)
+			dest[i] = lightmap[i] * scale;
+	}
+	else
+	{
+		for (; i < size; i++)
+			dest[i] += lightmap[i] * scale;
+	}
+}
+
+/*
+===============
+R_BoundLightmap
+
+bound, invert, and shift blocklights into colormap rows
+===============
+*/
+static void
+R_BoundLightmap (int size)
+{
+	int	i = 0;
+
+#if defined(SW_SIMD_NEON)
+	{
+		int32x4_t	full = vdupq_n_s32(255*256);
+		int32x4_t	minlight = vdupq_n_s32(1 << 6);
+		int32x4_t	zero = vdupq_n_s32(0);
+
+		for (; i + 4 <= size; i += 4)
+		{
+			int32x4_t	t = vreinterpretq_s32_u32(vld1q_u32(blocklights + i));
+
+			t = vmaxq_s32(t, zero);
+			t = vshrq_n_s32(vsubq_s32(full, t), 8 - VID_CBITS);
+			t = vmaxq_s32(t, minlight);
+			vst1q_u32(blocklights + i, vreinterpretq_u32_s32(t));
+		}
+	}
+#elif defined(SW_SIMD_SSE2)
+	{
+		__m128i	full = _mm_set1_epi32(255*256);
+		__m128i	minlight = _mm_set1_epi32(1 << 6);
+		__m128i	zero = _mm_setzero_si128();
+
+		for (; i + 4 <= size; i += 4)
+		{
+			__m128i	t, m;
+
+			t = _mm_loadu_si128((const __m128i *)(blocklights + i));
+			t = _mm_andnot_si128(_mm_cmplt_epi32(t, zero), t);
+			t = _mm_srai_epi32(_mm_sub_epi32(full, t), 8 - VID_CBITS);
+			m = _mm_cmplt_epi32(t, minlight);
+			t = _mm_or_si128(_mm_and_si128(m, minlight), _mm_andnot_si128(m, t));
+			_mm_storeu_si128((__m128i *)(blocklights + i), t);
+		}
+	}
+#endif
+
+	for (; i<size ; i++)
+	{
+		int t;
+
+		t = (int)blocklights[i];
+		if (t < 0)
+			t = 0;
+		t = (255*256 - t) >> (8 - VID_CBITS);
+
+		if (t < (1 << 6))
+			t = (1 << 6);
+
+		blocklights[i] = t;
+	}
+}
+
 /*
 ===============
 R_BuildLightMap
@@ -385,6 +531,7 @@ R_BuildLightMap (drawsurf_t* drawsurf)
 	int			i, size;
 	byte		*lightmap;
 	msurface_t	*surf;
+	int			maps;
 
 	surf = drawsurf->surf;
 
@@ -399,46 +546,31 @@ R_BuildLightMap (drawsurf_t* drawsurf)
 		return;
 	}
 
-	// clear to no light
-	for (i=0 ; i<size ; i++)
-		blocklights[i] = 0;
-
-
 	// add all the lightmaps
 	lightmap = surf->samples;
+	maps = 0;
 	if (lightmap)
 	{
-		int maps;
-
-		for (maps = 0 ; maps < MAXLIGHTMAPS && surf->styles[maps] != 255 ;
+		for ( ; maps < MAXLIGHTMAPS && surf->styles[maps] != 255 ;
 			 maps++)
 		{
-			unsigned scale;
-
-			scale = drawsurf->lightadj[maps];	// 8.8 fraction
-			for (i=0 ; i<size ; i++)
-				blocklights[i] += lightmap[i] * scale;
+			// 8.8 fraction
+			R_AccumulateLightmap (lightmap, drawsurf->lightadj[maps],
+					size, maps == 0);
 			lightmap += size;	// skip to next lightmap
 		}
 	}
 
+	// clear to no light
+	if (!maps)
+	{
+		for (i=0 ; i<size ; i++)
+			blocklights[i] = 0;
+	}
+
 	// add all the dynamic lights
 	if (surf->dlightframe == r_framecount)
 		R_AddDynamicLights (drawsurf);
 
-	// bound, invert, and shift
-	for (i=0 ; i<size ; i++)
-	{
-		int t;
-
-		t = (int)blocklights[i];
-		if (t < 0)
-			t = 0;
-		t = (255*256 - t) >> (8 - VID_CBITS);
-
-		if (t < (1 << 6))
-			t = (1 << 6);
-
-		blocklights[i] = t;
-	}
+	R_BoundLightmap (size);
 }
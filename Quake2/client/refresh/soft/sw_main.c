@@ -150,6 +150,11 @@ static cvar_t	*vid_gamma;
 
 //PGM
 static cvar_t	*r_lockpvs;
+static cvar_t	*sw_threads;
+static cvar_t	*sw_nullvideo;
+static qboolean	nullvideo;
+static cvar_t	*sw_framecrc;
+cvar_t	*sw_occlusion;
 //PGM
 
 // sw_vars.c
@@ -310,6 +315,15 @@ R_RegisterVariables (void)
 	//PGM
 	r_lockpvs = ri.Cvar_Get ("r_lockpvs", "0", 0);
 	//PGM
+
+	sw_threads = ri.Cvar_Get("sw_threads", "0", CVAR_ARCHIVE);
+	sw_threads->modified = true; // RE_Shutdown stopped the band threads, start them again
+	// settable from autoexec.cfg or the console, only read when the
+	// renderer starts, so a change needs a vid_restart
+	sw_nullvideo = ri.Cvar_Get("sw_nullvideo", "0", 0);
+	nullvideo = (sw_nullvideo->value != 0);
+	sw_framecrc = ri.Cvar_Get("sw_framecrc", "0", 0);
+	sw_occlusion = ri.Cvar_Get("sw_occlusion", "1", CVAR_ARCHIVE);
 }
 
 static void
@@ -324,6 +338,177 @@ static void RE_ShutdownContext(void);
 static void SWimp_CreateRender(void);
 static int RE_InitContext(void *win);
 
+/*
+==============================================================================
+
+BAND WORKERS
+
+Frame stages that only read one buffer and write disjoint rows of another
+(the palette expansion in RE_CopyFrame and the underwater warp) are split
+into horizontal bands and handed to sw_threads helper threads, the calling
+thread taking the first band itself. Every band produces exactly the pixels
+the serial loop would, so the output does not depend on the thread count.
+
+Edge and span rasterization stays on the main thread: the active edge
+table, the surface stack and the span cache are shared globals that are
+rebuilt as the scan walks down the screen.
+
+==============================================================================
+*/
+
+#define MAX_BAND_THREADS	7
+
+typedef struct
+{
+	SDL_Thread	*thread;
+	SDL_sem		*start;
+	int		y0, y1;
+} bandworker_t;
+
+static bandworker_t	band_workers[MAX_BAND_THREADS];
+static int		band_numworkers;
+static SDL_sem		*band_done;
+static qboolean		band_quit;
+static bandfunc_t	band_func;
+static void		*band_data;
+
+static int SDLCALL
+R_BandThread(void *arg)
+{
+	bandworker_t *worker = (bandworker_t *)arg;
+
+	for (;;)
+	{
+		SDL_SemWait(worker->start);
+
+		if (band_quit)
+			break;
+
+		band_func(band_data, worker->y0, worker->y1);
+		SDL_SemPost(band_done);
+	}
+
+	return 0;
+}
+
+static void
+R_ShutdownBandThreads(void)
+{
+	int	i;
+
+	if (!band_numworkers)
+		return;
+
+	band_quit = true;
+
+	for (i = 0; i < band_numworkers; i++)
+	{
+		SDL_SemPost(band_workers[i].start);
+		SDL_WaitThread(band_workers[i].thread, NULL);
+		SDL_DestroySemaphore(band_workers[i].start);
+	}
+
+	SDL_DestroySemaphore(band_done);
+	band_done = NULL;
+	band_numworkers = 0;
+	band_quit = false;
+}
+
+static void
+R_StartBandThreads(int count)
+{
+	int	i;
+
+	R_ShutdownBandThreads();
+
+	if (count > MAX_BAND_THREADS)
+		count = MAX_BAND_THREADS;
+
+	if (count <= 0)
+		return;
+
+	band_done = SDL_CreateSemaphore(0);
+	if (!band_done)
+	{
+		R_Printf(PRINT_ALL, "%s: %s\n", __func__, SDL_GetError());
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		bandworker_t *worker = &band_workers[i];
+
+		worker->start = SDL_CreateSemaphore(0);
+		if (!worker->start)
+			break;
+
+		worker->thread = SDL_CreateThread(R_BandThread, "sw_band", worker);
+		if (!worker->thread)
+		{
+			SDL_DestroySemaphore(worker->start);
+			break;
+		}
+
+		band_numworkers++;
+	}
+
+	if (band_numworkers < count)
+		R_Printf(PRINT_ALL, "%s: started %d of %d threads: %s\n",
+				__func__, band_numworkers, count, SDL_GetError());
+
+	if (!band_numworkers)
+	{
+		SDL_DestroySemaphore(band_done);
+		band_done = NULL;
+	}
+}
+
+/*
+================
+R_RunBands
+
+Calls func over rows [0, height) split in one band per available thread
+and returns once all of them are done.
+================
+*/
+void
+R_RunBands(bandfunc_t func, void *data, int height)
+{
+	int	i, bands, y;
+
+	if (sw_threads->modified)
+	{
+		sw_threads->modified = false;
+		R_StartBandThreads((int)sw_threads->value);
+	}
+
+	bands = band_numworkers + 1;
+
+	// not worth waking anybody for a handful of rows
+	if (bands == 1 || height < bands * 16)
+	{
+		func(data, 0, height);
+		return;
+	}
+
+	band_func = func;
+	band_data = data;
+
+	y = height / bands;
+	for (i = 0; i < band_numworkers; i++)
+	{
+		band_workers[i].y0 = y;
+		y = (i + 2) * height / bands;
+		band_workers[i].y1 = y;
+		SDL_SemPost(band_workers[i].start);
+	}
+
+	func(data, 0, height / bands);
+
+	for (i = 0; i < band_numworkers; i++)
+		SDL_SemWait(band_done);
+}
+
 /*
 ===============
 R_Init
@@ -388,6 +573,7 @@ RE_Shutdown (void)
 		free (vid_colormap);
 		vid_colormap = NULL;
 	}
+	R_ShutdownBandThreads ();
 	R_UnRegister ();
 	Mod_FreeAll ();
 	R_ShutdownImages ();
@@ -1125,6 +1311,7 @@ RE_RenderFrame (refdef_t *fd)
 
 	// Draw enemies, barrel etc...
 	// Use Z-Buffer in read mode only.
+	D_InvalidateCoarseZ ();
 	R_DrawEntitiesOnList ();
 
 	if (r_dspeeds->value)
@@ -1167,6 +1354,8 @@ RE_RenderFrame (refdef_t *fd)
 		R_PrintDSpeeds ();
 
 	R_ReallocateMapBuffers();
+
+	D_GrowCaches();
 }
 
 /*
@@ -1504,7 +1693,7 @@ void R_Printf(int level, const char* msg, ...)
 static qboolean
 RE_IsVsyncActive(void)
 {
-	if (r_vsync->value)
+	if (r_vsync->value && !nullvideo)
 	{
 		return true;
 	}
@@ -1700,6 +1889,12 @@ RE_ShutdownContext(void)
 	}
 	warp_column = NULL;
 
+	if (d_coarsez)
+	{
+		free(d_coarsez);
+	}
+	d_coarsez = NULL;
+
 	if (edge_basespans)
 	{
 		free(edge_basespans);
@@ -1749,42 +1944,124 @@ point math used in R_ScanEdges() overflows at width 2048 !!
 */
 char shift_size;
 
+typedef struct
+{
+	Uint32	*pixels;
+	int	pitch;
+} copyframe_t;
+
+/*
+** RE_ExpandPixels
+**
+** Palette lookup of count pixels. gamma and the blend from R_CalcPalette
+** are already folded into the 256 entry table, so this is all there is
+** to it. AArch64 NEON splits the table into four byte planes and looks
+** up sixteen pixels per plane with table lookups of 64 bytes each,
+** vst4q puts the bytes back together. SSE2 has no gather, but
+** assembling four lookups into one 16 byte store still halves the time
+** of the plain loop.
+*/
 static void
-RE_CopyFrame (Uint32 * pixels, int pitch)
+RE_ExpandPixels (Uint32 *pixels, const pixel_t *buffer_pos, const Uint32 *sdl_palette, int count)
 {
-	Uint32 *sdl_palette = (Uint32 *)sw_state.currentpalette;
+	const Uint32	*max_pixels;
 
-	// no gaps between images rows
-	if (pitch == vid.width)
-	{
-		const Uint32	*max_pixels;
-		Uint32	*pixels_pos;
-		pixel_t	*buffer_pos;
+	max_pixels = pixels + count;
 
-		max_pixels = pixels + vid.height * vid.width;
-		buffer_pos = vid_buffer;
+#if defined(SW_SIMD_NEON) && defined(__aarch64__)
+	if (count >= 64)
+	{
+		// plane[k][c] holds byte c of palette entries 64*k .. 64*k+63
+		uint8x16x4_t	plane[4][4];
+		int	k, j, c;
 
-		for (pixels_pos = pixels; pixels_pos < max_pixels; pixels_pos++)
+		for (k = 0; k < 4; k++)
 		{
-			*pixels_pos = sdl_palette[*buffer_pos];
-			buffer_pos++;
+			for (j = 0; j < 4; j++)
+			{
+				uint8x16x4_t	entries;
+
+				entries = vld4q_u8((const uint8_t *)(sdl_palette + 64 * k + 16 * j));
+				for (c = 0; c < 4; c++)
+					plane[k][c].val[j] = entries.val[c];
+			}
 		}
-	}
-	else
-	{
-		int y,x, buffer_pos;
 
-		buffer_pos = 0;
-		for (y=0; y < vid.height;  y++)
+		for (; pixels + 16 <= max_pixels; pixels += 16, buffer_pos += 16)
 		{
-			for (x=0; x < vid.width; x ++)
+			uint8x16_t	index[4];
+			uint8x16x4_t	out;
+
+			index[0] = vld1q_u8(buffer_pos);
+			index[1] = vsubq_u8(index[0], vdupq_n_u8(64));
+			index[2] = vsubq_u8(index[0], vdupq_n_u8(128));
+			index[3] = vsubq_u8(index[0], vdupq_n_u8(192));
+
+			// out of range indices leave the byte alone, so
+			// each of the four lookups fills in its own quarter
+			for (c = 0; c < 4; c++)
 			{
-				pixels[x] = sdl_palette[vid_buffer[buffer_pos + x]];
+				out.val[c] = vqtbl4q_u8(plane[0][c], index[0]);
+				out.val[c] = vqtbx4q_u8(out.val[c], plane[1][c], index[1]);
+				out.val[c] = vqtbx4q_u8(out.val[c], plane[2][c], index[2]);
+				out.val[c] = vqtbx4q_u8(out.val[c], plane[3][c], index[3]);
 			}
-			pixels += pitch;
-			buffer_pos += vid.width;
+
+			vst4q_u8((uint8_t *)pixels, out);
 		}
 	}
+#elif defined(SW_SIMD_SSE2)
+	for (; pixels + 4 <= max_pixels; pixels += 4, buffer_pos += 4)
+	{
+		_mm_storeu_si128((__m128i *)pixels,
+			_mm_setr_epi32(sdl_palette[buffer_pos[0]], sdl_palette[buffer_pos[1]],
+				sdl_palette[buffer_pos[2]], sdl_palette[buffer_pos[3]]));
+	}
+#endif
+
+	for (; pixels < max_pixels; pixels++)
+	{
+		*pixels = sdl_palette[*buffer_pos];
+		buffer_pos++;
+	}
+}
+
+static void
+RE_CopyFrameRows (void *data, int y0, int y1)
+{
+	const copyframe_t *copy = (const copyframe_t *)data;
+	const Uint32 *sdl_palette = (const Uint32 *)sw_state.currentpalette;
+	const pixel_t *buffer_pos;
+	Uint32 *pixels;
+	int y;
+
+	pixels = copy->pixels + y0 * copy->pitch;
+	buffer_pos = vid_buffer + y0 * vid.width;
+
+	// no gaps between images rows
+	if (copy->pitch == vid.width)
+	{
+		RE_ExpandPixels(pixels, buffer_pos, sdl_palette, (y1 - y0) * vid.width);
+		return;
+	}
+
+	for (y = y0; y < y1; y++)
+	{
+		RE_ExpandPixels(pixels, buffer_pos, sdl_palette, vid.width);
+		pixels += copy->pitch;
+		buffer_pos += vid.width;
+	}
+}
+
+static void
+RE_CopyFrame (Uint32 * pixels, int pitch)
+{
+	copyframe_t	copy;
+
+	copy.pixels = pixels;
+	copy.pitch = pitch;
+
+	R_RunBands(RE_CopyFrameRows, &copy, vid.height);
 }
 
 /*
@@ -1795,12 +2072,58 @@ RE_CopyFrame (Uint32 * pixels, int pitch)
 ** on whether we're using DIB sections/GDI or DDRAW.
 */
 
+static unsigned	framecrc_table[256];
+static int	framecrc_count;
+
+/*
+** RE_FrameCRC
+**
+** CRC-32 of the finished 8 bit frame, used to check that
+** renderer changes produce identical output for a demo.
+*/
+static unsigned
+RE_FrameCRC (void)
+{
+	const pixel_t	*pos, *end;
+	unsigned	crc;
+
+	if (!framecrc_table[1])
+	{
+		unsigned	i, j, c;
+
+		for (i = 0; i < 256; i++)
+		{
+			c = i;
+			for (j = 0; j < 8; j++)
+				c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+			framecrc_table[i] = c;
+		}
+	}
+
+	crc = 0xffffffff;
+	end = vid_buffer + vid.width * vid.height;
+	for (pos = vid_buffer; pos < end; pos++)
+		crc = framecrc_table[(crc ^ *pos) & 0xff] ^ (crc >> 8);
+
+	return crc ^ 0xffffffff;
+}
+
 static void
 RE_EndFrame (void)
 {
 	int pitch;
 	Uint32 * pixels;
 
+	if (sw_framecrc->value)
+	{
+		R_Printf(PRINT_ALL, "frame %d crc %08x\n",
+				framecrc_count++, RE_FrameCRC());
+	}
+
+	// headless: the frame stays in vid_buffer
+	if (nullvideo)
+		return;
+
 	if (SDL_LockTexture(texture, NULL, (void**)&pixels, &pitch))
 	{
 		Com_Printf("Can't lock texture: %s\n", SDL_GetError());
@@ -1831,6 +2154,16 @@ SWimp_SetMode(int *pwidth, int *pheight, int mode, int fullscreen )
 
 	R_Printf( PRINT_ALL, " %d %d\n", *pwidth, *pheight);
 
+	if (nullvideo)
+	{
+		// no window, renderer or texture, just the software buffers
+		ri.Vid_SetSize(*pwidth, *pheight);
+		RE_ShutdownContext();
+		SWimp_CreateRender();
+
+		return retval;
+	}
+
 	if (!ri.GLimp_InitGraphics(fullscreen, pwidth, pheight))
 	{
 		// failed to set a valid mode in windowed mode
@@ -1857,6 +2190,9 @@ SWimp_CreateRender(void)
 	warp_rowptr = malloc((vid.width+AMP2*2) * sizeof(byte*));
 	warp_column = malloc((vid.width+AMP2*2) * sizeof(int));
 
+	d_coarsez = malloc(((vid.width + COARSEZ_SIZE - 1) >> COARSEZ_SHIFT) *
+			   ((vid.height + COARSEZ_SIZE - 1) >> COARSEZ_SHIFT) * sizeof(zvalue_t));
+
 	edge_basespans = malloc((vid.width*2) * sizeof(espan_t));
 
 	// count of "out of items"
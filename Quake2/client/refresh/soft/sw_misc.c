@@ -90,9 +90,11 @@ R_PrintTimes (void)
 
 	ms = r_time2 - r_time1;
 
-	R_Printf(PRINT_ALL,"%5i ms %3i/%3i/%3i poly %3i surf\n",
-				ms, c_faceclip, r_polycount, r_drawnpolycount, c_surf);
+	R_Printf(PRINT_ALL,"%5i ms %3i/%3i/%3i poly %3i surf %2i occluded\n",
+				ms, c_faceclip, r_polycount, r_drawnpolycount, c_surf,
+				r_amodels_occluded);
 	c_surf = 0;
+	r_amodels_occluded = 0;
 }
 
 
@@ -116,8 +118,12 @@ R_PrintDSpeeds (void)
 	de_time = (de_time2 - de_time1);
 	ms = (r_time2 - r_time1);
 
-	R_Printf(PRINT_ALL,"%3i %2ip %2iw %2ib %2is %2ie %2ia\n",
-				ms, dp_time, rw_time, db_time, se_time, de_time, da_time);
+	R_Printf(PRINT_ALL,"%3i %2ip %2iw %2ib %2is %2ie %2ia %4i cached %3i built %2i thrash\n",
+				ms, dp_time, rw_time, db_time, se_time, de_time, da_time,
+				c_surfhits, c_surfbuilt, c_surfthrash);
+	c_surfhits = 0;
+	c_surfbuilt = 0;
+	c_surfthrash = 0;
 }
 
 
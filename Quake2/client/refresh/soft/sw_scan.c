@@ -21,6 +21,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 //
 // Portable C scan-level rasterization code, all pixel depths.
 
+#include <limits.h>
+
 #include "header/local.h"
 
 
@@ -29,6 +31,37 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 byte	**warp_rowptr;
 int	*warp_column;
 
+/*
+=============
+D_WarpScreenRows
+
+Warps rows [y0, y1) of the view; rows are independent of each other.
+=============
+*/
+static void
+D_WarpScreenRows (void *data, int y0, int y1)
+{
+	const int	*turb = (const int *)data;
+	int	w, u, v;
+	pixel_t	*dest;
+	byte	**row;
+
+	w = r_newrefdef.width;
+	dest = vid_buffer + (r_newrefdef.y + y0) * vid.width + r_newrefdef.x;
+
+	for (v=y0 ; v<y1 ; v++, dest += vid.width)
+	{
+		const int *col;
+
+		col = warp_column + turb[v];
+		row = warp_rowptr + v;
+		for (u=0 ; u<w ; u++)
+		{
+			dest[u] = row[turb[u]][col[u]];
+		}
+	}
+}
+
 /*
 =============
 D_WarpScreen
@@ -42,9 +75,7 @@ D_WarpScreen (void)
 {
 	int	w, h;
 	int	u,v;
-	pixel_t	*dest;
 	int	*turb;
-	byte	**row;
 
 	static int	cached_width, cached_height;
 
@@ -75,21 +106,149 @@ D_WarpScreen (void)
 	}
 
 	turb = intsintable + ((int)(r_newrefdef.time*SPEED)&(CYCLE-1));
-	dest = vid_buffer + r_newrefdef.y * vid.width + r_newrefdef.x;
+	R_RunBands(D_WarpScreenRows, turb, h);
+}
+
+
+/*
+==============================================================================
 
-	for (v=0 ; v<h ; v++, dest += vid.width)
+COARSE Z
+
+Once the world is in the z buffer every pixel of the view holds the 1/z
+of the world (or an entity) drawn there. The coarse buffer keeps, per
+tile of COARSEZ_SIZE x COARSEZ_SIZE pixels, the smallest of those values,
+i.e. the farthest thing visible in the tile. Anything whose nearest
+point is farther than that in every tile it covers cannot show up.
+
+==============================================================================
+*/
+
+zvalue_t	*d_coarsez;
+
+static int	coarsez_width, coarsez_height;
+static qboolean	coarsez_valid;
+
+/*
+=============
+D_InvalidateCoarseZ
+
+Called before entities are drawn; the coarse buffer is built from the
+z buffer on first use
+=============
+*/
+void
+D_InvalidateCoarseZ (void)
+{
+	coarsez_valid = false;
+}
+
+static void
+D_BuildCoarseZ (void)
+{
+	int	tu, tv, u, v;
+	int	x0, y0, w, h;
+
+	x0 = r_refdef.vrect.x;
+	y0 = r_refdef.vrect.y;
+	w = r_refdef.vrect.width;
+	h = r_refdef.vrect.height;
+
+	if (!d_coarsez)
+		return;
+
+	coarsez_width = (w + COARSEZ_SIZE - 1) >> COARSEZ_SHIFT;
+	coarsez_height = (h + COARSEZ_SIZE - 1) >> COARSEZ_SHIFT;
+
+	for (tv = 0; tv < coarsez_height; tv++)
 	{
-		int *col;
+		int	vmax = (tv + 1) << COARSEZ_SHIFT;
 
-		col = warp_column + turb[v];
-		row = warp_rowptr + v;
-		for (u=0 ; u<w ; u++)
+		if (vmax > h)
+			vmax = h;
+
+		for (tu = 0; tu < coarsez_width; tu++)
 		{
-			dest[u] = row[turb[u]][col[u]];
+			int		umax = (tu + 1) << COARSEZ_SHIFT;
+			zvalue_t	zmin = INT_MAX;
+
+			if (umax > w)
+				umax = w;
+
+			for (v = tv << COARSEZ_SHIFT; v < vmax; v++)
+			{
+				const zvalue_t	*pz = d_pzbuffer + (y0 + v) * vid.width + x0;
+
+				for (u = tu << COARSEZ_SHIFT; u < umax; u++)
+				{
+					if (pz[u] < zmin)
+						zmin = pz[u];
+				}
+			}
+
+			d_coarsez[tv * coarsez_width + tu] = zmin;
 		}
 	}
+
+	coarsez_valid = true;
 }
 
+/*
+=============
+D_RectOccluded
+
+True when nothing at 1/z izi or farther inside the screen rectangle
+[u0, u1] x [v0, v1] can pass the z test
+=============
+*/
+qboolean
+D_RectOccluded (int u0, int v0, int u1, int v1, zvalue_t izi)
+{
+	int	tu, tv;
+
+	if (!coarsez_valid)
+	{
+		D_BuildCoarseZ();
+		if (!coarsez_valid)
+			return false;
+	}
+
+	// to view relative tiles, clipped to the view
+	u0 -= r_refdef.vrect.x;
+	u1 -= r_refdef.vrect.x;
+	v0 -= r_refdef.vrect.y;
+	v1 -= r_refdef.vrect.y;
+
+	if (u0 < 0)
+		u0 = 0;
+	if (v0 < 0)
+		v0 = 0;
+	if (u1 >= r_refdef.vrect.width)
+		u1 = r_refdef.vrect.width - 1;
+	if (v1 >= r_refdef.vrect.height)
+		v1 = r_refdef.vrect.height - 1;
+
+	if (u0 > u1 || v0 > v1)
+		return false;
+
+	u0 >>= COARSEZ_SHIFT;
+	u1 >>= COARSEZ_SHIFT;
+	v0 >>= COARSEZ_SHIFT;
+	v1 >>= COARSEZ_SHIFT;
+
+	for (tv = v0; tv <= v1; tv++)
+	{
+		const zvalue_t	*pz = d_coarsez + tv * coarsez_width;
+
+		for (tu = u0; tu <= u1; tu++)
+		{
+			if (pz[tu] <= izi)
+				return false;
+		}
+	}
+
+	return true;
+}
 
 /*
 =============
@@ -537,12 +696,32 @@ D_DrawSpan(pixel_t *pdest, const pixel_t *pbase, int s, int t, int sstep, int ts
 	// diagonal span
 	else
 	{
-		do
+		// four independent texel addresses per round
+		while (pdest + 4 <= tdest_max)
+		{
+			int	o0, o1, o2, o3;
+
+			o0 = (s >> SHIFT16XYZ) + (t >> SHIFT16XYZ) * cachewidth;
+			o1 = ((s + sstep) >> SHIFT16XYZ) + ((t + tstep) >> SHIFT16XYZ) * cachewidth;
+			o2 = ((s + sstep * 2) >> SHIFT16XYZ) + ((t + tstep * 2) >> SHIFT16XYZ) * cachewidth;
+			o3 = ((s + sstep * 3) >> SHIFT16XYZ) + ((t + tstep * 3) >> SHIFT16XYZ) * cachewidth;
+
+			pdest[0] = pbase[o0];
+			pdest[1] = pbase[o1];
+			pdest[2] = pbase[o2];
+			pdest[3] = pbase[o3];
+
+			pdest += 4;
+			s += sstep * 4;
+			t += tstep * 4;
+		}
+
+		while (pdest < tdest_max)
 		{
 			*pdest++ = *(pbase + (s >> SHIFT16XYZ) + (t >> SHIFT16XYZ) * cachewidth);
 			s += sstep;
 			t += tstep;
-		} while (pdest < tdest_max);
+		}
 	}
 
 	return pdest;
@@ -737,6 +916,65 @@ D_DrawSpansPow2 (espan_t *pspan)
 	} while ((pspan = pspan->pnext) != NULL);
 }
 
+/*
+=============
+D_DrawZSpanRow
+
+Writes count z values stepping izi by izistep, four at a time where
+the vector unit allows; the output matches the scalar loop exactly.
+=============
+*/
+static void
+D_DrawZSpanRow (zvalue_t *pdest, zvalue_t izi, zvalue_t izistep, int count)
+{
+#if defined(SW_SIMD_NEON)
+	if (count >= 4)
+	{
+		const int32_t	ramp[4] = {0, 1, 2, 3};
+		int32x4_t	vizi, vstep;
+
+		vizi = vmlaq_n_s32(vdupq_n_s32(izi), vld1q_s32(ramp), izistep);
+		vstep = vdupq_n_s32(izistep * 4);
+
+		do
+		{
+			vst1q_s32(pdest, vshrq_n_s32(vizi, SHIFT16XYZ));
+			vizi = vaddq_s32(vizi, vstep);
+			pdest += 4;
+			count -= 4;
+		} while (count >= 4);
+
+		izi = vgetq_lane_s32(vizi, 0);
+	}
+#elif defined(SW_SIMD_SSE2)
+	if (count >= 4)
+	{
+		__m128i	vizi, vstep;
+
+		vizi = _mm_setr_epi32(izi, izi + izistep,
+				izi + izistep * 2, izi + izistep * 3);
+		vstep = _mm_set1_epi32(izistep * 4);
+
+		do
+		{
+			_mm_storeu_si128((__m128i *)pdest, _mm_srai_epi32(vizi, SHIFT16XYZ));
+			vizi = _mm_add_epi32(vizi, vstep);
+			pdest += 4;
+			count -= 4;
+		} while (count >= 4);
+
+		izi = _mm_cvtsi128_si32(vizi);
+	}
+#endif
+
+	while (count > 0)
+	{
+		*pdest++ = izi >> SHIFT16XYZ;
+		izi += izistep;
+		count--;
+	}
+}
+
 /*
 =============
 D_DrawZSpans
@@ -790,12 +1028,7 @@ D_DrawZSpans (espan_t *pspan)
 		}
 		else
 		{
-			while (count > 0)
-			{
-				*pdest++ = izi >> SHIFT16XYZ;
-				izi += izistep;
-				count--;
-			}
+			D_DrawZSpanRow(pdest, izi, izistep, count);
 		}
 	} while ((pspan = pspan->pnext) != NULL);
 }
@@ -40,6 +40,17 @@ static int	sc_size;
 static surfcache_t	*sc_rover;
 surfcache_t	*sc_base;
 
+// a block drawn this frame had to be evicted, see D_GrowCaches
+static qboolean	sc_thrashed;
+// a bigger cache couldn't be allocated, stop trying until R_InitCaches
+static qboolean	sc_nogrow;
+
+int	c_surfhits, c_surfbuilt, c_surfthrash;
+
+// how many recently drawn blocks D_SCAlloc steps over before
+// it gives up and evicts whatever is under the rover
+#define SC_MAXSKIP	16
+
 /*
 ===============
 R_TextureAnimation
@@ -192,6 +203,44 @@ R_DrawSurface (drawsurf_t *drawsurf)
 
 //=============================================================================
 
+/*
+================
+D_AllocCaches
+================
+*/
+static qboolean
+D_AllocCaches (int size)
+{
+	surfcache_t	*base;
+
+	// round up to page size
+	size = (size + 8191) & ~8191;
+
+	// the old cache stays in place if there isn't enough memory
+	base = (surfcache_t *)malloc(size);
+	if (!base)
+		return false;
+
+	if (sc_base)
+	{
+		D_FlushCaches ();
+		free (sc_base);
+	}
+
+	R_Printf(PRINT_ALL,"%ik surface cache\n", size/1024);
+
+	sc_size = size;
+	sc_base = base;
+	sc_rover = sc_base;
+	sc_thrashed = false;
+
+	sc_base->next = NULL;
+	sc_base->owner = NULL;
+	sc_base->size = sc_size;
+
+	return true;
+}
+
 /*
 ================
 R_InitCaches
@@ -218,18 +267,10 @@ R_InitCaches (void)
 			size += (pix-64000)*3;
 	}
 
-	// round up to page size
-	size = (size + 8191) & ~8191;
+	sc_nogrow = false;
 
-	R_Printf(PRINT_ALL,"%ik surface cache\n", size/1024);
-
-	sc_size = size;
-	sc_base = (surfcache_t *)malloc(size);
-	sc_rover = sc_base;
-
-	sc_base->next = NULL;
-	sc_base->owner = NULL;
-	sc_base->size = sc_size;
+	if (!D_AllocCaches(size))
+		ri.Sys_Error (ERR_FATAL,"R_InitCaches: couldn't allocate %i byte surface cache", size);
 }
 
 
@@ -258,15 +299,74 @@ D_FlushCaches (void)
 	sc_base->size = sc_size;
 }
 
+/*
+==================
+D_GrowCaches
+
+Called after each frame. A frame that evicted surfaces it had already
+drawn needs more cache than there is, so double it; the cache starts
+from the resolution based guess and grows to what the map needs.
+==================
+*/
+void
+D_GrowCaches (void)
+{
+	int	size;
+
+	if (!sc_thrashed)
+		return;
+
+	sc_thrashed = false;
+
+	if (sw_surfcacheoverride->value || sc_nogrow || sc_size >= SURFCACHE_SIZE_MAX)
+		return;
+
+	size = sc_size * 2;
+	if (size > SURFCACHE_SIZE_MAX)
+		size = SURFCACHE_SIZE_MAX;
+
+	if (!D_AllocCaches (size))
+	{
+		R_Printf(PRINT_ALL,"Couldn't grow the surface cache to %ik\n", size/1024);
+		sc_nogrow = true;
+	}
+}
+
+/*
+=================
+D_SCEvict
+=================
+*/
+static void
+D_SCEvict (surfcache_t *c)
+{
+	if (!c->owner)
+		return;
+
+	if (c->lastframe == r_framecount)
+	{
+		c_surfthrash++;
+		sc_thrashed = true;
+	}
+
+	*c->owner = NULL;
+}
+
 /*
 =================
 D_SCAlloc
+
+The rover walks the cache as a ring, evicting what it passes, which
+makes it roughly FIFO. Blocks drawn in the current or the previous
+frame get a second chance: the rover steps over a few of them to find
+an older block, which keeps the working set of the view resident.
 =================
 */
 static surfcache_t *
 D_SCAlloc (int width, int size)
 {
 	surfcache_t	*new;
+	int		skip;
 
 	if ((width < 0) || (width > 256))
 		ri.Sys_Error (ERR_FATAL,"D_SCAlloc: bad cache width %d\n", width);
@@ -286,10 +386,24 @@ D_SCAlloc (int width, int size)
 		sc_rover = sc_base;
 	}
 
+	// step over recently drawn blocks
+	for (skip = 0; skip < SC_MAXSKIP; skip++)
+	{
+		surfcache_t	*next;
+
+		if (!sc_rover->owner || sc_rover->lastframe < r_framecount - 1)
+			break;
+
+		next = sc_rover->next;
+		if (!next || (byte *)next - (byte *)sc_base > sc_size - size)
+			break;
+
+		sc_rover = next;
+	}
+
 	// colect and free surfcache_t blocks until the rover block is large enough
 	new = sc_rover;
-	if (sc_rover->owner)
-		*sc_rover->owner = NULL;
+	D_SCEvict (sc_rover);
 
 	while (new->size < size)
 	{
@@ -297,8 +411,7 @@ D_SCAlloc (int width, int size)
 		sc_rover = sc_rover->next;
 		if (!sc_rover)
 			ri.Sys_Error (ERR_FATAL,"D_SCAlloc: hit the end of memory");
-		if (sc_rover->owner)
-			*sc_rover->owner = NULL;
+		D_SCEvict (sc_rover);
 
 		new->size += sc_rover->size;
 		new->next = sc_rover->next;
@@ -362,7 +475,11 @@ D_CacheSurface (const entity_t *currententity, msurface_t *surface, int miplevel
 			&& cache->lightadj[1] == r_drawsurf.lightadj[1]
 			&& cache->lightadj[2] == r_drawsurf.lightadj[2]
 			&& cache->lightadj[3] == r_drawsurf.lightadj[3] )
+	{
+		cache->lastframe = r_framecount;
+		c_surfhits++;
 		return cache;
+	}
 
 	//
 	// determine shape of surface
@@ -390,6 +507,8 @@ D_CacheSurface (const entity_t *currententity, msurface_t *surface, int miplevel
 	else
 		cache->dlight = 0;
 
+	cache->lastframe = r_framecount;
+
 	r_drawsurf.surfdat = (pixel_t *)cache->data;
 
 	cache->image = r_drawsurf.image;
@@ -404,6 +523,7 @@ D_CacheSurface (const entity_t *currententity, msurface_t *surface, int miplevel
 	r_drawsurf.surf = surface;
 
 	c_surf++;
+	c_surfbuilt++;
 
 	// calculate the lightings
 	R_BuildLightMap (&r_drawsurf);
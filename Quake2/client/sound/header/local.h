@@ -66,6 +66,7 @@ typedef struct sfx_s
 	int registration_sequence;
 	sfxcache_t *cache;
 	char *truename;
+	struct sfx_s *hashnext; /* next sfx in the same name hash chain */
 } sfx_t;
 
 /* A playsound_t will be generated by each call
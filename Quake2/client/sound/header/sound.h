@@ -50,6 +50,12 @@ struct sfx_s *S_RegisterSound(char *sample);
 void S_EndRegistration(void);
 struct sfx_s *S_FindName(char *name, qboolean create);
 
+/* Resolves all sexed ('*') sounds of the level for the
+   player model named in a clientinfo string. sequence
+   is set to the registration the table is valid for. */
+#define MAX_SEXED_SOUNDS 32
+void S_RegisterSexedSounds(char *cinfo, struct sfx_s **sounds, int *sequence);
+
 /* the sound code makes callbacks to the client for
    entitiy position information, so entities can be 
    dynamically re-spatialized */
@@ -36,6 +36,17 @@
 /* SDL includes */
 #include <SDL.h>
 
+/* The mixer has vector paths for NEON (all iOS and
+   tvOS devices) and SSE2 (the simulators). Everything
+   else uses the plain C loops. */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SDL_MIX_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define SDL_MIX_SSE2
+#include <emmintrin.h>
+#endif
+
 /* Local includes */
 #include "../../client/header/client.h"
 #include "../../client/sound/header/local.h"
@@ -224,7 +235,29 @@ SDL_TransferPaintBuffer(int endtime)
 
 			snd_linear_count <<= 1;
 
-			for (i = 0; i < snd_linear_count; i += 2)
+			i = 0;
+
+			/* scale down and clip, the saturating
+			   narrow does both in one go */
+#if defined(SDL_MIX_NEON)
+			for ( ; i + 8 <= snd_linear_count; i += 8)
+			{
+				int32x4_t lo = vshrq_n_s32(vld1q_s32(snd_p + i), 8);
+				int32x4_t hi = vshrq_n_s32(vld1q_s32(snd_p + i + 4), 8);
+
+				vst1q_s16(snd_out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+			}
+#elif defined(SDL_MIX_SSE2)
+			for ( ; i + 8 <= snd_linear_count; i += 8)
+			{
+				__m128i lo = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(snd_p + i)), 8);
+				__m128i hi = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(snd_p + i + 4)), 8);
+
+				_mm_storeu_si128((__m128i *)(snd_out + i), _mm_packs_epi32(lo, hi));
+			}
+#endif
+
+			for ( ; i < snd_linear_count; i += 2)
 			{
 				val = snd_p[i] >> 8;
 
@@ -374,8 +407,29 @@ SDL_PaintChannelFrom16(channel_t *ch, sfxcache_t *sc, int count, int offset)
 	sfx = (signed short *)sc->data + ch->pos;
 
 	samp = &paintbuffer[offset];
+	i = 0;
 
-	for (i = 0; i < count; i++, samp++)
+#if defined(SDL_MIX_NEON)
+	{
+		int32x4_t lv = vdupq_n_s32(leftvol);
+		int32x4_t rv = vdupq_n_s32(rightvol);
+
+		/* 4 sample pairs at a time, vld2 splits them
+		   into a left and a right vector */
+		for ( ; i + 4 <= count; i += 4, samp += 4)
+		{
+			int32x4_t in = vmovl_s16(vld1_s16(sfx + i));
+			int32x4x2_t out = vld2q_s32((int32_t *)samp);
+
+			out.val[0] = vaddq_s32(out.val[0], vshrq_n_s32(vmulq_s32(in, lv), 8));
+			out.val[1] = vaddq_s32(out.val[1], vshrq_n_s32(vmulq_s32(in, rv), 8));
+
+			vst2q_s32((int32_t *)samp, out);
+		}
+	}
+#endif
+
+	for ( ; i < count; i++, samp++)
 	{
 		data = sfx[i];
 		left = (data * leftvol) >> 8;
@@ -892,6 +946,20 @@ SDL_UpdateScaletable(void)
 	}
 }
 
+/*
+ * Reads one source sample as 16 bit
+ */
+static int
+SDL_CacheSample(wavinfo_t *info, byte *data, int index)
+{
+	if (info->width == 2)
+	{
+		return LittleShort(((short *)data)[index]);
+	}
+
+	return (int)((unsigned char)(data[index]) - 128) << 8;
+}
+
 /*
  * Saves a sound sample into cache. If
  * necessary endianess convertions are
@@ -903,8 +971,9 @@ SDL_Cache(sfx_t *sfx, wavinfo_t *info, byte *data)
 	float stepscale;
 	int i;
 	int len;
-	int sample;
+	int sample, next;
 	int srcsample;
+	int frac;
 	sfxcache_t *sc;
 	unsigned int samplefrac = 0;
 
@@ -952,20 +1021,20 @@ SDL_Cache(sfx_t *sfx, wavinfo_t *info, byte *data)
 		sc->width = info->width;
 	}
 
-	/* resample / decimate to the current source rate */
+	/* resample / decimate to the current source rate,
+	   interpolating linearly between source samples */
 	for (i = 0; i < (int)(info->samples / stepscale); i++)
 	{
 		srcsample = samplefrac >> 8;
+		frac = samplefrac & 0xff;
 		samplefrac += (int)(stepscale * 256);
 
-		if (info->width == 2)
-		{
-			sample = LittleShort(((short *)data)[srcsample]);
-		}
+		sample = SDL_CacheSample(info, data, srcsample);
 
-		else
+		if (frac && (srcsample + 1 < info->samples))
 		{
-			sample = (int)((unsigned char)(data[srcsample]) - 128) << 8;
+			next = SDL_CacheSample(info, data, srcsample + 1);
+			sample += ((next - sample) * frac) >> 8;
 		}
 
 		if (sc->width == 2)
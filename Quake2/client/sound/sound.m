@@ -39,6 +39,7 @@
    because we don't want to free anything until we are
    sure we won't need it. */
 #define MAX_SFX (MAX_SOUNDS * 2)
+#define SFX_HASH_SIZE 256 /* must be a power of two */
 #define MAX_PLAYSOUNDS 128
 
 vec3_t listener_origin;
@@ -60,6 +61,7 @@ cvar_t *s_ambient;
 cvar_t* s_underwater;
 cvar_t* s_underwater_gain_hf;
 cvar_t* s_doppler;
+cvar_t *s_cachesize;
 
 channel_t channels[MAX_CHANNELS];
 int num_sfx;
@@ -70,10 +72,20 @@ int s_registration_sequence;
 portable_samplepair_t s_rawsamples[MAX_RAW_SAMPLES];
 qboolean snd_initialized = false;
 sfx_t known_sfx[MAX_SFX];
+static sfx_t *sfx_hash[SFX_HASH_SIZE];
 sndstarted_t sound_started = SS_NOT;
 sound_t sound;
 static qboolean s_registering;
 
+/* the sexed sounds ('*' names) of the current
+   registration, see S_RegisterSexedSounds() */
+static sfx_t *s_sexedsounds[MAX_SEXED_SOUNDS];
+static int s_numsexedsounds;
+
+/* registration statistics, reported by S_EndRegistration() */
+static int s_reghits;
+static int s_regmisses;
+
 qboolean snd_is_underwater;
 qboolean snd_is_underwater_enabled;
 /* ----------------------------------------------------------------- */
@@ -166,66 +178,194 @@ S_LoadSound(sfx_t *s)
 }
 
 /*
- * Returns the name of a sound
+ * Returns the memory used by a loaded sample
  */
-sfx_t *
-S_FindName(char *name, qboolean create)
+static int
+S_CacheSize(const sfxcache_t *sc)
 {
-	int i;
-	sfx_t *sfx;
+#if USE_OPENAL
+	if (sound_started == SS_OAL)
+	{
+		return sc->size;
+	}
+#endif
 
-	if (!name)
+	return sc->length * sc->width + sizeof(sfxcache_t);
+}
+
+static unsigned int
+S_HashName(const char *name)
+{
+	unsigned int hash;
+
+	/* FNV-1a */
+	hash = 2166136261u;
+
+	while (*name)
 	{
-		Com_Error(ERR_FATAL, "S_FindName: NULL\n");
+		hash ^= (unsigned char)*name++;
+		hash *= 16777619u;
 	}
 
-	if (!name[0])
+	return hash & (SFX_HASH_SIZE - 1);
+}
+
+/*
+ * Makes a named sfx visible to S_FindName()
+ */
+static void
+S_LinkSfx(sfx_t *sfx)
+{
+	unsigned int hash;
+
+	hash = S_HashName(sfx->name);
+	sfx->hashnext = sfx_hash[hash];
+	sfx_hash[hash] = sfx;
+}
+
+static void
+S_UnlinkSfx(sfx_t *sfx)
+{
+	sfx_t **link;
+
+	for (link = &sfx_hash[S_HashName(sfx->name)]; *link; link = &(*link)->hashnext)
 	{
-		Com_Error(ERR_FATAL, "S_FindName: empty name\n");
+		if (*link == sfx)
+		{
+			*link = sfx->hashnext;
+			break;
+		}
 	}
 
-	if (strlen(name) >= MAX_QPATH)
+	sfx->hashnext = NULL;
+}
+
+/*
+ * Frees a sound and its sample
+ */
+static void
+S_FreeSfx(sfx_t *sfx)
+{
+#if USE_OPENAL
+	if (sound_started == SS_OAL)
 	{
-		Com_Error(ERR_FATAL, "Sound name too long: %s", name);
+		AL_DeleteSfx(sfx);
 	}
+#endif
+
+	if (sfx->cache)
+	{
+		Z_Free(sfx->cache);
+	}
+
+	if (sfx->truename)
+	{
+		Z_Free(sfx->truename);
+	}
+
+	if (sfx->name[0])
+	{
+		S_UnlinkSfx(sfx);
+	}
+
+	sfx->cache = NULL;
+	sfx->truename = NULL;
+	sfx->name[0] = 0;
+}
+
+/*
+ * Returns a free sfx slot. If all slots are
+ * taken, the sound that was used least recently
+ * by a level is thrown out of the cache.
+ */
+static sfx_t *
+S_AllocSfx(void)
+{
+	int i, oldest;
 
-	/* see if already loaded */
 	for (i = 0; i < num_sfx; i++)
 	{
-		if (!strcmp(known_sfx[i].name, name))
+		if (!known_sfx[i].name[0])
 		{
 			return &known_sfx[i];
 		}
 	}
 
-	if (!create)
+	if (num_sfx < MAX_SFX)
 	{
-		return NULL;
+		return &known_sfx[num_sfx++];
 	}
 
-	/* find a free sfx */
+	oldest = -1;
+
 	for (i = 0; i < num_sfx; i++)
 	{
-		if (!known_sfx[i].name[0])
+		if (known_sfx[i].registration_sequence == s_registration_sequence)
 		{
-			break;
+			continue;
+		}
+
+		if ((oldest == -1) || (known_sfx[i].registration_sequence <
+				known_sfx[oldest].registration_sequence))
+		{
+			oldest = i;
 		}
 	}
 
-	if (i == num_sfx)
+	if (oldest == -1)
 	{
-		if (num_sfx == MAX_SFX)
+		Com_Error(ERR_FATAL, "S_FindName: out of sfx_t");
+	}
+
+	S_FreeSfx(&known_sfx[oldest]);
+
+	return &known_sfx[oldest];
+}
+
+/*
+ * Returns the name of a sound
+ */
+sfx_t *
+S_FindName(char *name, qboolean create)
+{
+	sfx_t *sfx;
+
+	if (!name)
+	{
+		Com_Error(ERR_FATAL, "S_FindName: NULL\n");
+	}
+
+	if (!name[0])
+	{
+		Com_Error(ERR_FATAL, "S_FindName: empty name\n");
+	}
+
+	if (strlen(name) >= MAX_QPATH)
+	{
+		Com_Error(ERR_FATAL, "Sound name too long: %s", name);
+	}
+
+	/* see if already loaded */
+	for (sfx = sfx_hash[S_HashName(name)]; sfx; sfx = sfx->hashnext)
+	{
+		if (!strcmp(sfx->name, name))
 		{
-			Com_Error(ERR_FATAL, "S_FindName: out of sfx_t");
+			return sfx;
 		}
+	}
 
-		num_sfx++;
+	if (!create)
+	{
+		return NULL;
 	}
 
-	sfx = &known_sfx[i];
+	/* find a free sfx */
+	sfx = S_AllocSfx();
+	sfx->cache = NULL;
 	sfx->truename = NULL;
 	strcpy(sfx->name, name);
 	sfx->registration_sequence = s_registration_sequence;
+	S_LinkSfx(sfx);
 
 	return sfx;
 }
@@ -239,35 +379,18 @@ S_AliasName(char *aliasname, char *truename)
 {
 	sfx_t *sfx;
 	char *s;
-	int i;
-
-	s = Z_Malloc(MAX_QPATH);
-	strcpy(s, truename);
 
 	/* find a free sfx */
-	for (i = 0; i < num_sfx; i++)
-	{
-		if (!known_sfx[i].name[0])
-		{
-			break;
-		}
-	}
-
-	if (i == num_sfx)
-	{
-		if (num_sfx == MAX_SFX)
-		{
-			Com_Error(ERR_FATAL, "S_FindName: out of sfx_t");
-		}
+	sfx = S_AllocSfx();
 
-		num_sfx++;
-	}
+	s = Z_Malloc(MAX_QPATH);
+	strcpy(s, truename);
 
-	sfx = &known_sfx[i];
 	sfx->cache = NULL;
 	strcpy(sfx->name, aliasname);
 	sfx->registration_sequence = s_registration_sequence;
 	sfx->truename = s;
+	S_LinkSfx(sfx);
 
 	return sfx;
 }
@@ -281,6 +404,11 @@ S_BeginRegistration(void)
 {
 	s_registration_sequence++;
 	s_registering = true;
+
+	s_reghits = 0;
+	s_regmisses = 0;
+
+	s_numsexedsounds = 0;
 }
 
 /*
@@ -290,6 +418,7 @@ sfx_t *
 S_RegisterSound(char *name)
 {
 	sfx_t *sfx;
+	int i;
 
 	if (sound_started == SS_NOT)
 	{
@@ -299,31 +428,52 @@ S_RegisterSound(char *name)
 	sfx = S_FindName(name, true);
 	sfx->registration_sequence = s_registration_sequence;
 
+	if (name[0] == '*')
+	{
+		for (i = 0; i < s_numsexedsounds; i++)
+		{
+			if (s_sexedsounds[i] == sfx)
+			{
+				break;
+			}
+		}
+
+		if ((i == s_numsexedsounds) && (i < MAX_SEXED_SOUNDS))
+		{
+			s_sexedsounds[s_numsexedsounds++] = sfx;
+		}
+	}
+
 	if (!s_registering)
 	{
 		S_LoadSound(sfx);
 	}
+	else if (sfx->cache)
+	{
+		s_reghits++;
+	}
+	else
+	{
+		s_regmisses++;
+	}
 
 	return sfx;
 }
 
-struct sfx_s *
-S_RegisterSexedSound(entity_state_t *ent, char *base)
+/*
+ * Extracts the model name from a
+ * player's clientinfo string
+ */
+static void
+S_SexedModelName(const char *cinfo, char *model)
 {
-	int n;
-	struct sfx_s *sfx;
-	char model[MAX_QPATH];
-	char sexedFilename[MAX_QPATH];
-	char maleFilename[MAX_QPATH];
+	char *p;
 
-	/* determine what model the client is using */
 	model[0] = 0;
-	n = CS_PLAYERSKINS + ent->number - 1;
 
-	if (cl.configstrings[n][0])
+	if (cinfo[0])
 	{
-		char *p;
-		p = strchr(cl.configstrings[n], '\\');
+		p = strchr(cinfo, '\\');
 
 		if (p)
 		{
@@ -343,6 +493,14 @@ S_RegisterSexedSound(entity_state_t *ent, char *base)
 	{
 		strcpy(model, "male");
 	}
+}
+
+static sfx_t *
+S_ResolveSexedSound(char *model, char *base)
+{
+	sfx_t *sfx;
+	char sexedFilename[MAX_QPATH];
+	char maleFilename[MAX_QPATH];
 
 	/* see if we already know of the model specific sound */
 	Com_sprintf(sexedFilename, sizeof(sexedFilename),
@@ -373,6 +531,105 @@ S_RegisterSexedSound(entity_state_t *ent, char *base)
 	return sfx;
 }
 
+struct sfx_s *
+S_RegisterSexedSound(entity_state_t *ent, char *base)
+{
+	char model[MAX_QPATH];
+
+	/* determine what model the client is using */
+	S_SexedModelName(cl.configstrings[CS_PLAYERSKINS + ent->number - 1], model);
+
+	return S_ResolveSexedSound(model, base);
+}
+
+/*
+ * Builds the table of sexed sounds for a player. Its
+ * slots follow s_sexedsounds, so S_StartSound() can
+ * look a sound up without string operations or file
+ * system probes. The table is valid as long as the
+ * registration sequence doesn't change, the sounds
+ * in it are protected from being evicted until then.
+ */
+void
+S_RegisterSexedSounds(char *cinfo, struct sfx_s **sounds, int *sequence)
+{
+	char model[MAX_QPATH];
+	sfx_t *sfx;
+	int i;
+
+	memset(sounds, 0, MAX_SEXED_SOUNDS * sizeof(sounds[0]));
+	*sequence = -1;
+
+	if ((sound_started == SS_NOT) || s_registering)
+	{
+		return;
+	}
+
+	S_SexedModelName(cinfo, model);
+
+	for (i = 0; i < s_numsexedsounds; i++)
+	{
+		sfx = S_ResolveSexedSound(model, s_sexedsounds[i]->name);
+
+		if (sfx)
+		{
+			sfx->registration_sequence = s_registration_sequence;
+		}
+
+		sounds[i] = sfx;
+	}
+
+	*sequence = s_registration_sequence;
+}
+
+/*
+ * Maps a sexed sound to the one matching
+ * the model of the entity playing it.
+ */
+static sfx_t *
+S_SexedSound(int entnum, sfx_t *sfx)
+{
+	clientinfo_t *ci;
+	int i;
+
+	if ((entnum >= 1) && (entnum <= MAX_CLIENTS))
+	{
+		ci = &cl.clientinfo[entnum - 1];
+
+		if (ci->sexedsequence == s_registration_sequence)
+		{
+			for (i = 0; i < s_numsexedsounds; i++)
+			{
+				if ((s_sexedsounds[i] == sfx) && ci->sexedsounds[i])
+				{
+					return ci->sexedsounds[i];
+				}
+			}
+		}
+	}
+
+	/* not in the table, resolve it the slow way */
+	return S_RegisterSexedSound(&cl_entities[entnum].current, sfx->name);
+}
+
+/*
+ * Most recently used first, ties
+ * keep the order of known_sfx
+ */
+static int
+S_CompareUnused(const void *a, const void *b)
+{
+	const sfx_t *sa = *(const sfx_t **)a;
+	const sfx_t *sb = *(const sfx_t **)b;
+
+	if (sa->registration_sequence != sb->registration_sequence)
+	{
+		return sb->registration_sequence - sa->registration_sequence;
+	}
+
+	return (sa < sb) ? -1 : (sa > sb);
+}
+
 /*
  * Called after registering of
  * sound has ended
@@ -381,38 +638,59 @@ void
 S_EndRegistration(void)
 {
 	int i;
+	int budget, kept, size;
+	int numunused;
+	sfx_t *unused[MAX_SFX];
 	sfx_t *sfx;
 
-	/* free any sounds not from this registration sequence */
+	/* Sounds not used by this level stay loaded as
+	   long as they fit into s_cachesize kilobytes,
+	   most recently used first. Moving between the
+	   units of an episode doesn't reload everything
+	   they share. Sounds without a sample or from a
+	   server that didn't finish loading are freed. */
+	budget = (int)s_cachesize->value * 1024;
+	kept = 0;
+	numunused = 0;
+
 	for (i = 0, sfx = known_sfx; i < num_sfx; i++, sfx++)
 	{
-		if (!sfx->name[0])
+		if (!sfx->name[0] ||
+			(sfx->registration_sequence == s_registration_sequence))
 		{
 			continue;
 		}
 
-		if (sfx->registration_sequence != s_registration_sequence)
+		if (!sfx->cache)
 		{
-			/* it is possible to have a leftover */
-			if (sfx->cache)
-			{
-				Z_Free(sfx->cache); /* from a server that didn't finish loading */
-			}
+			S_FreeSfx(sfx);
+			continue;
+		}
 
-			if (sfx->truename)
-			{
-				Z_Free(sfx->truename);
-			}
+		unused[numunused++] = sfx;
+	}
+
+	qsort(unused, numunused, sizeof(unused[0]), S_CompareUnused);
 
-			sfx->cache = NULL;
-			sfx->name[0] = 0;
+	for (i = 0; i < numunused; i++)
+	{
+		size = S_CacheSize(unused[i]->cache);
+
+		if (kept + size <= budget)
+		{
+			kept += size;
+		}
+		else
+		{
+			S_FreeSfx(unused[i]);
 		}
 	}
 
 	/* load everything in */
 	for (i = 0, sfx = known_sfx; i < num_sfx; i++, sfx++)
 	{
-		if (!sfx->name[0])
+		if (!sfx->name[0] ||
+			(sfx->registration_sequence != s_registration_sequence))
 		{
 			continue;
 		}
@@ -420,6 +698,9 @@ S_EndRegistration(void)
 		S_LoadSound(sfx);
 	}
 
+	Com_DPrintf("Sound registration: %i of %i cached, %i KB of unused sounds kept\n",
+			s_reghits, s_reghits + s_regmisses, kept / 1024);
+
 	s_registering = false;
 }
 
@@ -636,7 +917,7 @@ S_StartSound(vec3_t origin, int entnum, int entchannel, sfx_t *sfx,
 
 	if (sfx->name[0] == '*')
 	{
-		sfx = S_RegisterSexedSound(&cl_entities[entnum].current, sfx->name);
+		sfx = S_SexedSound(entnum, sfx);
 
 		if (!sfx)
 		{
@@ -1061,6 +1342,7 @@ S_Init(void)
     s_underwater = Cvar_Get("s_underwater", "1", CVAR_ARCHIVE);
     s_underwater_gain_hf = Cvar_Get("s_underwater_gain_hf", "0.25", CVAR_ARCHIVE);
 	s_doppler = Cvar_Get("s_doppler", "1", CVAR_ARCHIVE);
+	s_cachesize = Cvar_Get("s_cachesize", "8192", CVAR_ARCHIVE);
 
 	Cmd_AddCommand("play", S_Play);
 	Cmd_AddCommand("stopsound", S_StopAllSounds);
@@ -1125,25 +1407,11 @@ S_Shutdown(void)
 			continue;
 		}
 
-#if USE_OPENAL
-		if (sound_started == SS_OAL)
-		{
-			AL_DeleteSfx(sfx);
-		}
-#endif
-
-		if (sfx->cache)
-		{
-			Z_Free(sfx->cache);
-		}
-
-		if (sfx->truename)
-		{
-			Z_Free(sfx->truename);
-		}
+		S_FreeSfx(sfx);
 	}
 
 	memset(known_sfx, 0, sizeof(known_sfx));
+	memset(sfx_hash, 0, sizeof(sfx_hash));
 	num_sfx = 0;
 
 #if USE_OPENAL
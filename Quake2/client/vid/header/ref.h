@@ -117,7 +117,7 @@ typedef struct {
 } refdef_t;
 
 // FIXME: bump API_VERSION?
-#define	API_VERSION		5
+#define	API_VERSION		6
 #define EXPORT
 #define IMPORT
 
@@ -231,6 +231,8 @@ typedef struct
 	void		(IMPORT *Vid_WriteScreenshot)( int width, int height, int comp, const void* data );
 
 	qboolean	(IMPORT *GLimp_InitGraphics)(int fullscreen, int *pwidth, int *pheight);
+	// tells the client the window size when no window is created by GLimp_InitGraphics()
+	void		(IMPORT *Vid_SetSize)( int width, int height );
 } refimport_t;
 
 // this is the only function actually exported at the linker level
@@ -47,6 +47,7 @@ extern viddef_t viddef;
 void	VID_Init(void);
 void	VID_Shutdown(void);
 void	VID_CheckChanges(void);
+void	VID_SetSize(int width, int height);
 
 void	VID_MenuInit(void);
 void	VID_MenuDraw(void);
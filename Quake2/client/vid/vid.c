@@ -312,6 +312,18 @@ VID_Restart_f(void)
 	vid_fullscreen->modified = true;
 }
 
+/*
+ * Sets the window size the client works with. Normally
+ * GLimp_InitGraphics() does this, renderers running
+ * without a window (sw_nullvideo) call it directly.
+ */
+void
+VID_SetSize(int width, int height)
+{
+	viddef.width = width;
+	viddef.height = height;
+}
+
 /*
  * Shuts the renderer down and unloads it.
  */
@@ -413,6 +425,7 @@ VID_LoadRenderer(void)
 	ri.Sys_Error = Com_Error;
 	ri.Vid_GetModeInfo = VID_GetModeInfo;
 	ri.Vid_MenuInit = VID_MenuInit;
+	ri.Vid_SetSize = VID_SetSize;
 	ri.Vid_WriteScreenshot = VID_WriteScreenshot;
 
 	// Exchange our export struct with the renderers import struct.
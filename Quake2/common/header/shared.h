@@ -34,6 +34,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
@@ -293,6 +294,7 @@ int randk(void);
 float frandk(void);
 float crandk(void);
 void randk_seed(void);
+void randk_redirect(uint64_t *state);
 
 /*
  * ==============================================================
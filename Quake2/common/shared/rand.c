@@ -25,6 +25,10 @@ static int j;
 static uint64_t carry;
 static uint64_t xs;
 static uint64_t cng;
+
+/* When set, randk() draws from this small
+   xorshift state instead of the KISS state. */
+static uint64_t *redirect;
   
 uint64_t
 B64MWC(void)
@@ -46,8 +50,23 @@ int
 randk(void)
 {
 	int r;
+	uint64_t x;
+
+	if (redirect)
+	{
+		x = *redirect;
+		x ^= x >> 12;
+		x ^= x << 25;
+		x ^= x >> 27;
+		*redirect = x;
+
+		r = (int)((x * 2685821657736338717ULL) >> 32);
+	}
+	else
+	{
+		r = (int)KISS;
+	}
 
-	r = (int)KISS;
 	r = (r < 0) ? (r * -1) : r;
 
 	return r;
@@ -95,3 +114,15 @@ randk_seed(void)
 	}
 }
 
+/*
+ * Makes randk() use the given state
+ * (must not be 0) until called with
+ * NULL. The KISS state is too large
+ * to snapshot, this gives the server
+ * a reproducible stream for replays.
+ */
+void
+randk_redirect(uint64_t *state)
+{
+	redirect = state;
+}
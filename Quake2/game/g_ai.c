@@ -617,11 +617,9 @@ FindTarget(edict_t *self)
 			return false;
 		}
 
-		if (!visible(self, client))
-		{
-			return false;
-		}
-
+		/* the facing tests are cheap and have no side
+		   effects, so do them before tracing the line
+		   of sight. Most monsters fail them. */
 		if (r == RANGE_NEAR)
 		{
 			if ((client->show_hostile < (int)level.time) && !infront(self, client))
@@ -637,6 +635,11 @@ FindTarget(edict_t *self)
 			}
 		}
 
+		if (!visible(self, client))
+		{
+			return false;
+		}
+
 		self->enemy = client;
 
 		if (strcmp(self->enemy->classname, "player_noise") != 0)
@@ -746,6 +749,18 @@ M_CheckAttack(edict_t *self)
 		return false;
 	}
 
+	/* a missile attack that can't happen doesn't
+	   need the trace, none of these use random */
+	if (enemy_range != RANGE_MELEE)
+	{
+		if (!self->monsterinfo.attack ||
+			(level.time < self->monsterinfo.attack_finished) ||
+			(enemy_range == RANGE_FAR))
+		{
+			return false;
+		}
+	}
+
 	if (self->enemy->health > 0)
 	{
 		/* see if any entities are in the way of the shot */
@@ -787,21 +802,6 @@ M_CheckAttack(edict_t *self)
 	}
 
 	/* missile attack */
-	if (!self->monsterinfo.attack)
-	{
-		return false;
-	}
-
-	if (level.time < self->monsterinfo.attack_finished)
-	{
-		return false;
-	}
-
-	if (enemy_range == RANGE_FAR)
-	{
-		return false;
-	}
-
 	if (self->monsterinfo.aiflags & AI_STAND_GROUND)
 	{
 		chance = 0.4;
@@ -1249,6 +1249,7 @@ ai_run(edict_t *self, float dist)
 	}
 
 	VectorCopy(self->monsterinfo.last_sighting, self->goalentity->s.origin);
+	G_WakeEntity(self->goalentity);
 
 	if (new)
 	{
@@ -1292,6 +1293,7 @@ ai_run(edict_t *self, float dist)
 						self->monsterinfo.saved_goal);
 				self->monsterinfo.aiflags |= AI_PURSUE_TEMP;
 				VectorCopy(left_target, self->goalentity->s.origin);
+				G_WakeEntity(self->goalentity);
 				VectorCopy(left_target, self->monsterinfo.last_sighting);
 				VectorSubtract(self->goalentity->s.origin, self->s.origin, v);
 				self->s.angles[YAW] = self->ideal_yaw = vectoyaw(v);
@@ -1309,6 +1311,7 @@ ai_run(edict_t *self, float dist)
 						self->monsterinfo.saved_goal);
 				self->monsterinfo.aiflags |= AI_PURSUE_TEMP;
 				VectorCopy(right_target, self->goalentity->s.origin);
+				G_WakeEntity(self->goalentity);
 				VectorCopy(right_target, self->monsterinfo.last_sighting);
 				VectorSubtract(self->goalentity->s.origin, self->s.origin, v);
 				self->s.angles[YAW] = self->ideal_yaw = vectoyaw(v);
@@ -158,6 +158,7 @@ Killed(edict_t *targ, edict_t *inflictor, edict_t *attacker,
 		(targ->movetype == MOVETYPE_NONE))
 	{
 		/* doors, triggers, etc */
+		G_WakeEntity(targ);
 		targ->die(targ, inflictor, attacker, damage, point);
 		return;
 	}
@@ -168,6 +169,7 @@ Killed(edict_t *targ, edict_t *inflictor, edict_t *attacker,
 		monster_death_use(targ);
 	}
 
+	G_WakeEntity(targ);
 	targ->die(targ, inflictor, attacker, damage, point);
 }
 
@@ -693,6 +695,7 @@ T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker,
 
 		if (!(targ->monsterinfo.aiflags & AI_DUCKED) && (take))
 		{
+			G_WakeEntity(targ);
 			targ->pain(targ, attacker, knockback, take);
 
 			/* nightmare mode monsters don't go into pain frames often */
@@ -706,6 +709,7 @@ T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker,
 	{
 		if (!(targ->flags & FL_GODMODE) && (take))
 		{
+			G_WakeEntity(targ);
 			targ->pain(targ, attacker, knockback, take);
 		}
 	}
@@ -713,6 +717,7 @@ T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker,
 	{
 		if (targ->pain)
 		{
+			G_WakeEntity(targ);
 			targ->pain(targ, attacker, knockback, take);
 		}
 	}
@@ -37,6 +37,7 @@ int snd_fry;
 int meansOfDeath;
 
 edict_t *g_edicts;
+unsigned int *g_awake; /* one bit per edict, see G_WakeEntity() */
 
 cvar_t *deathmatch;
 cvar_t *coop;
@@ -443,8 +444,26 @@ G_RunFrame(void)
 
 	for (i = 0; i < globals.num_edicts; i++, ent++)
 	{
+		/* sleeping entities have nothing to do,
+		   skip 32 of them at once if possible */
+		if (!(g_awake[i >> 5] & (1u << (i & 31))))
+		{
+			if (!g_awake[i >> 5])
+			{
+				i |= 31;
+				ent = &g_edicts[i];
+			}
+
+			continue;
+		}
+
 		if (!ent->inuse)
 		{
+			if (i > maxclients->value)
+			{
+				g_awake[i >> 5] &= ~(1u << (i & 31));
+			}
+
 			continue;
 		}
 
@@ -472,6 +491,11 @@ G_RunFrame(void)
 		}
 
 		G_RunEntity(ent);
+
+		if (G_EntityCanSleep(ent))
+		{
+			g_awake[i >> 5] &= ~(1u << (i & 31));
+		}
 	}
 
 	/* see if it is time to end a deathmatch */
@@ -2439,6 +2439,7 @@ func_clock_think(edict_t *self)
 	}
 
 	self->enemy->message = self->message;
+	G_WakeEntity(self->enemy);
 	self->enemy->use(self->enemy, self, self);
 
 	if (((self->spawnflags & 1) && (self->health > self->wait)) ||
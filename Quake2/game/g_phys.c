@@ -158,11 +158,13 @@ SV_Impact(edict_t *e1, trace_t *trace)
 
 	if (e1->touch && (e1->solid != SOLID_NOT))
 	{
+		G_WakeEntity(e1);
 		e1->touch(e1, e2, &trace->plane, trace->surface);
 	}
 
 	if (e2->touch && (e2->solid != SOLID_NOT))
 	{
+		G_WakeEntity(e2);
 		e2->touch(e2, e1, NULL, NULL);
 	}
 }
@@ -828,6 +830,7 @@ SV_Physics_Pusher(edict_t *ent)
 		   is gone */
 		if (part->blocked)
 		{
+			G_WakeEntity(part);
 			part->blocked(part, obstacle);
 		}
 	}
@@ -1014,6 +1017,7 @@ SV_Physics_Toss(edict_t *ent)
 	{
 		VectorCopy(ent->s.origin, slave->s.origin);
 		gi.linkentity(slave);
+		G_WakeEntity(slave);
 	}
 }
 
@@ -1230,6 +1234,73 @@ SV_Physics_Step(edict_t *ent)
 
 /* ================================================================== */
 
+/*
+ * Entities that G_RunEntity() has nothing
+ * to do for (not moving, no prethink and
+ * no think scheduled) are put to sleep and
+ * G_RunFrame() skips them, so the cost of
+ * a frame follows the number of active
+ * entities and not of all edicts. Spawning
+ * and the use, touch, pain, die and blocked
+ * callbacks wake an entity up again; code
+ * that changes another entity outside of
+ * those has to call G_WakeEntity() itself.
+ */
+void
+G_WakeEntity(edict_t *ent)
+{
+	int i;
+
+	if (!ent)
+	{
+		return;
+	}
+
+	i = ent - g_edicts;
+	g_awake[i >> 5] |= 1u << (i & 31);
+}
+
+void
+G_WakeAllEntities(void)
+{
+	memset(g_awake, 0xff, ((game.maxentities + 31) >> 5) * sizeof(g_awake[0]));
+}
+
+/*
+ * Returns true if the entity can sleep
+ * until something wakes it. The checks
+ * mirror what G_RunFrame() and
+ * G_RunEntity() would do for it.
+ */
+qboolean
+G_EntityCanSleep(edict_t *ent)
+{
+	if (!ent->inuse)
+	{
+		return true;
+	}
+
+	if ((ent->movetype != MOVETYPE_NONE) || ent->prethink)
+	{
+		return false;
+	}
+
+	/* a scheduled think keeps it awake */
+	if (ent->nextthink > 0)
+	{
+		return false;
+	}
+
+	/* G_RunFrame() still has to clear it */
+	if (ent->groundentity)
+	{
+		return false;
+	}
+
+	/* and to update old_origin once more */
+	return VectorCompare(ent->s.origin, ent->s.old_origin);
+}
+
 void
 G_RunEntity(edict_t *ent)
 {
@@ -314,6 +314,7 @@ G_UseTargets(edict_t *ent, edict_t *activator)
 			{
 				if (t->use)
 				{
+					G_WakeEntity(t);
 					t->use(t, ent, activator);
 				}
 			}
@@ -496,6 +497,7 @@ G_InitEdict(edict_t *e)
 	e->classname = "noclass";
 	e->gravity = 1.0;
 	e->s.number = e - g_edicts;
+	G_WakeEntity(e);
 }
 
 /*
@@ -603,6 +605,7 @@ G_TouchTriggers(edict_t *ent)
 			continue;
 		}
 
+		G_WakeEntity(hit);
 		hit->touch(hit, ent, NULL, NULL);
 	}
 }
@@ -640,6 +643,7 @@ G_TouchSolids(edict_t *ent)
 
 		if (ent->touch)
 		{
+			G_WakeEntity(hit);
 			ent->touch(hit, ent, NULL, NULL);
 		}
 
@@ -488,6 +488,7 @@ extern int gibsthisframe;
 extern int meansOfDeath;
 
 extern edict_t *g_edicts;
+extern unsigned int *g_awake;
 
 #define FOFS(x) (size_t)&(((edict_t *)NULL)->x)
 #define STOFS(x) (size_t)&(((spawn_temp_t *)NULL)->x)
@@ -771,6 +772,9 @@ void M_MoveToGoal(edict_t *ent, float dist);
 void M_ChangeYaw(edict_t *ent);
 
 /* g_phys.c */
+void G_WakeEntity(edict_t *ent);
+void G_WakeAllEntities(void);
+qboolean G_EntityCanSleep(edict_t *ent);
 void G_RunEntity(edict_t *ent);
 
 /* g_main.c */
@@ -848,6 +848,7 @@ medic_cable_attack(edict_t *self)
 		self->enemy->combattarget = NULL;
 		self->enemy->deathtarget = NULL;
 		self->enemy->owner = self;
+		G_WakeEntity(self->enemy);
 		ED_CallSpawn(self->enemy);
 		self->enemy->owner = NULL;
 
@@ -488,12 +488,105 @@ SV_FixCheckBottom(edict_t *ent)
 	ent->flags |= FL_PARTIALGROUND;
 }
 
+/*
+ * Directions that already failed during one
+ * SV_NewChaseDir() call. The fallback sweeps
+ * retry most of them, and each failed step
+ * costs several traces.
+ */
+#define MAX_CHASE_TRIES 16
+
+typedef struct
+{
+	qboolean checked;
+	qboolean valid;
+	int numblocked;
+	float blocked[MAX_CHASE_TRIES];
+} chasetries_t;
+
+/*
+ * A failed step leaves the origin untouched,
+ * so retrying it from the same spot gives the
+ * same result. That only holds as long as the
+ * relink after the failed step can't run any
+ * trigger code that changes the world.
+ */
+static qboolean
+M_TouchesTriggers(edict_t *ent)
+{
+	int i, num;
+	edict_t *touch[MAX_EDICTS];
+
+	/* dead things don't activate triggers! */
+	if ((ent->client || (ent->svflags & SVF_MONSTER)) && (ent->health <= 0))
+	{
+		return false;
+	}
+
+	num = gi.BoxEdicts(ent->absmin, ent->absmax, touch,
+			MAX_EDICTS, AREA_TRIGGERS);
+
+	for (i = 0; i < num; i++)
+	{
+		if (touch[i]->inuse && touch[i]->touch)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static qboolean
+SV_ChaseStep(edict_t *actor, float yaw, float dist, chasetries_t *tries)
+{
+	int i;
+
+	if (tries->valid)
+	{
+		for (i = 0; i < tries->numblocked; i++)
+		{
+			if (tries->blocked[i] == yaw)
+			{
+				/* same side effects as a failed
+				   SV_StepDirection(), minus the traces */
+				actor->ideal_yaw = yaw;
+				M_ChangeYaw(actor);
+				gi.linkentity(actor);
+				G_TouchTriggers(actor);
+				return false;
+			}
+		}
+	}
+
+	if (SV_StepDirection(actor, yaw, dist))
+	{
+		return true;
+	}
+
+	/* the first failure may have run trigger
+	   code, so it can't be trusted. Once nothing
+	   is touched, later failures are stable. */
+	if (!tries->checked)
+	{
+		tries->checked = true;
+		tries->valid = !M_TouchesTriggers(actor);
+	}
+	else if (tries->valid && (tries->numblocked < MAX_CHASE_TRIES))
+	{
+		tries->blocked[tries->numblocked++] = yaw;
+	}
+
+	return false;
+}
+
 void
 SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 {
 	float deltax, deltay;
 	float d[3];
 	float tdir, olddir, turnaround;
+	chasetries_t tries;
 
 	if (!actor || !enemy)
 	{
@@ -505,6 +598,10 @@ SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 		return;
 	}
 
+	tries.checked = false;
+	tries.valid = false;
+	tries.numblocked = 0;
+
 	olddir = anglemod((int)(actor->ideal_yaw / 45) * 45);
 	turnaround = anglemod(olddir - 180);
 
@@ -549,7 +646,7 @@ SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 			tdir = d[2] == 90 ? 135 : 215;
 		}
 
-		if ((tdir != turnaround) && SV_StepDirection(actor, tdir, dist))
+		if ((tdir != turnaround) && SV_ChaseStep(actor, tdir, dist, &tries))
 		{
 			return;
 		}
@@ -564,19 +661,19 @@ SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 	}
 
 	if ((d[1] != DI_NODIR) && (d[1] != turnaround) &&
-		SV_StepDirection(actor, d[1], dist))
+		SV_ChaseStep(actor, d[1], dist, &tries))
 	{
 		return;
 	}
 
 	if ((d[2] != DI_NODIR) && (d[2] != turnaround) &&
-		SV_StepDirection(actor, d[2], dist))
+		SV_ChaseStep(actor, d[2], dist, &tries))
 	{
 		return;
 	}
 
 	/* there is no direct path to the player, so pick another direction */
-	if ((olddir != DI_NODIR) && SV_StepDirection(actor, olddir, dist))
+	if ((olddir != DI_NODIR) && SV_ChaseStep(actor, olddir, dist, &tries))
 	{
 		return;
 	}
@@ -585,7 +682,7 @@ SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 	{
 		for (tdir = 0; tdir <= 315; tdir += 45)
 		{
-			if ((tdir != turnaround) && SV_StepDirection(actor, tdir, dist))
+			if ((tdir != turnaround) && SV_ChaseStep(actor, tdir, dist, &tries))
 			{
 				return;
 			}
@@ -595,14 +692,14 @@ SV_NewChaseDir(edict_t *actor, edict_t *enemy, float dist)
 	{
 		for (tdir = 315; tdir >= 0; tdir -= 45)
 		{
-			if ((tdir != turnaround) && SV_StepDirection(actor, tdir, dist))
+			if ((tdir != turnaround) && SV_ChaseStep(actor, tdir, dist, &tries))
 			{
 				return;
 			}
 		}
 	}
 
-	if ((turnaround != DI_NODIR) && SV_StepDirection(actor, turnaround, dist))
+	if ((turnaround != DI_NODIR) && SV_ChaseStep(actor, turnaround, dist, &tries))
 	{
 		return;
 	}
@@ -1483,6 +1483,7 @@ CopyToBodyQue(edict_t *ent)
 	body->takedamage = DAMAGE_YES;
 
 	gi.linkentity(body);
+	G_WakeEntity(body);
 }
 
 void
@@ -2362,6 +2363,7 @@ ClientThink(edict_t *ent, usercmd_t *ucmd)
 				continue;
 			}
 
+			G_WakeEntity(other);
 			other->touch(other, ent, NULL, NULL);
 		}
 	}
@@ -75,6 +75,7 @@ PlayerTrail_Add(vec3_t spot)
 	}
 
 	VectorCopy(spot, trail[trail_head]->s.origin);
+	G_WakeEntity(trail[trail_head]);
 
 	trail[trail_head]->timestamp = level.time;
 
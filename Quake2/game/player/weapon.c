@@ -135,6 +135,7 @@ PlayerNoise(edict_t *who, vec3_t where, int type)
 	}
 
 	VectorCopy(where, noise->s.origin);
+	G_WakeEntity(noise);
 	VectorSubtract(where, noise->maxs, noise->absmin);
 	VectorAdd(where, noise->maxs, noise->absmax);
 	noise->last_sound_time = level.time;
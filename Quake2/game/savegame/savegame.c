@@ -269,6 +269,7 @@ InitGame(void)
 	g_edicts = gi.TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
 	globals.edicts = g_edicts;
 	globals.max_edicts = game.maxentities;
+	g_awake = gi.TagMalloc(((game.maxentities + 31) >> 5) * sizeof(g_awake[0]), TAG_GAME);
 
 	/* initialize all clients for this game */
 	game.maxclients = maxclients->value;
@@ -894,6 +895,7 @@ ReadGame(const char *filename)
 
 	g_edicts = gi.TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
 	globals.edicts = g_edicts;
+	g_awake = gi.TagMalloc(((game.maxentities + 31) >> 5) * sizeof(g_awake[0]), TAG_GAME);
 
 	fread(&game, sizeof(game), 1, f);
 	game.clients = gi.TagMalloc(game.maxclients * sizeof(game.clients[0]),
@@ -1084,6 +1086,7 @@ ReadLevel(const char *filename)
 
 	/* wipe all the entities */
 	memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+	G_WakeAllEntities();
 	globals.num_edicts = maxclients->value + 1;
 
 	/* check edict size */
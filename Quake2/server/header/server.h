@@ -209,6 +209,8 @@ void Master_Heartbeat(void);
 void Master_Packet(void);
 
 void SV_InitGame(void);
+void SV_SpawnServer(char *server, char *spawnpoint, server_state_t serverstate,
+		qboolean attractloop, qboolean loadgame);
 void SV_Map(qboolean attractloop, char *levelstring, qboolean loadgame);
 
 void SV_PrepWorldFrame(void);
@@ -238,6 +240,7 @@ void SV_Status_f(void);
 
 void SV_WriteFrameToClient(client_t *client, sizebuf_t *msg);
 void SV_RecordDemoMessage(void);
+void SV_InvalidateHotEntities(void);
 void SV_BuildClientFrame(client_t *client);
 
 void SV_Error(char *error, ...);
@@ -256,6 +259,23 @@ void SV_WriteServerFile(qboolean autosave);
 void SV_Loadgame_f(void);
 void SV_Savegame_f(void);
 
+/* deterministic replays */
+void SV_ReplayEnterGame(void);
+void SV_ReplayLeaveGame(void);
+void SV_ReplaySpawn(char *server, char *spawnpoint);
+void SV_ReplayStop(void);
+void SV_ReplayRecordConnect(client_t *cl, char *userinfo);
+void SV_ReplayRecordBegin(client_t *cl);
+void SV_ReplayRecordUserinfo(client_t *cl);
+void SV_ReplayRecordCommand(client_t *cl, char *text);
+void SV_ReplayRecordServerCommand(void);
+void SV_ReplayRecordMove(client_t *cl, usercmd_t *cmd);
+void SV_ReplayRecordDisconnect(client_t *cl);
+void SV_ReplayRecordFrame(void);
+void SV_ReplayRecord_f(void);
+void SV_ReplayStop_f(void);
+void SV_Replay_f(void);
+
 /* high level object sorting to reduce interaction tests */
 void SV_ClearWorld(void);
 
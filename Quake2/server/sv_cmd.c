@@ -607,7 +607,10 @@ SV_ServerCommand_f(void)
 		return;
 	}
 
+	SV_ReplayRecordServerCommand();
+	SV_ReplayEnterGame();
 	ge->ServerCommand();
+	SV_ReplayLeaveGame();
 }
 
 void
@@ -632,6 +635,10 @@ SV_InitOperatorCommands(void)
 	Cmd_AddCommand("serverrecord", SV_ServerRecord_f);
 	Cmd_AddCommand("serverstop", SV_ServerStop_f);
 
+	Cmd_AddCommand("replayrecord", SV_ReplayRecord_f);
+	Cmd_AddCommand("replaystop", SV_ReplayStop_f);
+	Cmd_AddCommand("replay", SV_Replay_f);
+
 	Cmd_AddCommand("save", SV_Savegame_f);
 	Cmd_AddCommand("load", SV_Loadgame_f);
 
@@ -159,6 +159,7 @@ SVC_DirectConnect(void)
 	int version;
 	int qport;
 	int challenge;
+	qboolean accepted;
 
 	adr = net_from;
 
@@ -280,7 +281,12 @@ gotnewcl:
 	newcl->challenge = challenge; /* save challenge for checksumming */
 
 	/* get the game a chance to reject this connection or modify the userinfo */
-	if (!(ge->ClientConnect(ent, userinfo)))
+	SV_ReplayRecordConnect(newcl, userinfo);
+	SV_ReplayEnterGame();
+	accepted = ge->ClientConnect(ent, userinfo);
+	SV_ReplayLeaveGame();
+
+	if (!accepted)
 	{
 		if (*Info_ValueForKey(userinfo, "rejmsg"))
 		{
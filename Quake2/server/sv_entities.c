@@ -30,6 +30,29 @@
 
 byte fatpvs[65536 / 8];
 
+/*
+ * Hot subset of the edicts, kept as parallel arrays.
+ * Built once per server frame and shared by all clients,
+ * so the per client visibility tests walk dense arrays
+ * instead of striding through ge->edict_size bytes for
+ * every entity. Only entities that could ever be sent
+ * (no SVF_NOCLIENT, something visible or audible) are
+ * in here.
+ */
+#define HOT_BEAM 1
+#define HOT_NOMODEL 2
+
+static qboolean hot_valid;
+static int hot_num_entities;
+static int hot_number[MAX_EDICTS];
+static int hot_flags[MAX_EDICTS];
+static int hot_areanum[MAX_EDICTS];
+static int hot_areanum2[MAX_EDICTS];
+static int hot_headnode[MAX_EDICTS];
+static int hot_numclusters[MAX_EDICTS];
+static int hot_firstcluster[MAX_EDICTS];
+static int hot_clusters[MAX_EDICTS * MAX_ENT_CLUSTERS];
+
 /*
  * Writes a delta update of an entity_state_t list to the message.
  */
@@ -485,6 +508,78 @@ SV_FatPVS(vec3_t org)
 	}
 }
 
+/*
+ * Must be called whenever the game may have
+ * changed the edicts since the last build.
+ */
+void
+SV_InvalidateHotEntities(void)
+{
+	hot_valid = false;
+}
+
+static void
+SV_BuildHotEntities(void)
+{
+	int e, i, h, numclusters;
+	edict_t *ent;
+
+	h = 0;
+	numclusters = 0;
+
+	for (e = 1; e < ge->num_edicts; e++)
+	{
+		ent = EDICT_NUM(e);
+
+		/* ignore ents without visible models */
+		if (ent->svflags & SVF_NOCLIENT)
+		{
+			continue;
+		}
+
+		/* ignore ents without visible models unless they have an effect */
+		if (!ent->s.modelindex && !ent->s.effects &&
+			!ent->s.sound && !ent->s.event)
+		{
+			continue;
+		}
+
+		hot_number[h] = e;
+		hot_flags[h] = 0;
+		hot_areanum[h] = ent->areanum;
+		hot_areanum2[h] = ent->areanum2;
+		hot_headnode[h] = ent->headnode;
+		hot_firstcluster[h] = numclusters;
+
+		if (!ent->s.modelindex)
+		{
+			hot_flags[h] |= HOT_NOMODEL;
+		}
+
+		if (ent->s.renderfx & RF_BEAM)
+		{
+			/* beams just check one point for PHS */
+			hot_flags[h] |= HOT_BEAM;
+			hot_numclusters[h] = 1;
+			hot_clusters[numclusters++] = ent->clusternums[0];
+		}
+		else
+		{
+			hot_numclusters[h] = ent->num_clusters;
+
+			for (i = 0; i < ent->num_clusters; i++)
+			{
+				hot_clusters[numclusters++] = ent->clusternums[i];
+			}
+		}
+
+		h++;
+	}
+
+	hot_num_entities = h;
+	hot_valid = true;
+}
+
 /*
  * Decides which entities are going to be visible to the client, and
  * copies off the playerstat and areabits.
@@ -492,7 +587,8 @@ SV_FatPVS(vec3_t org)
 void
 SV_BuildClientFrame(client_t *client)
 {
-	int e, i;
+	int e, h, i;
+	int *clusters;
 	vec3_t org;
 	edict_t *ent;
 	edict_t *clent;
@@ -543,42 +639,37 @@ SV_BuildClientFrame(client_t *client)
 
 	c_fullsend = 0;
 
-	for (e = 1; e < ge->num_edicts; e++)
+	if (!hot_valid)
 	{
-		ent = EDICT_NUM(e);
-
-		/* ignore ents without visible models */
-		if (ent->svflags & SVF_NOCLIENT)
-		{
-			continue;
-		}
+		SV_BuildHotEntities();
+	}
 
-		/* ignore ents without visible models unless they have an effect */
-		if (!ent->s.modelindex && !ent->s.effects && 
-			!ent->s.sound && !ent->s.event)
-		{
-			continue;
-		}
+	for (h = 0; h < hot_num_entities; h++)
+	{
+		e = hot_number[h];
+		ent = EDICT_NUM(e);
 
 		/* ignore if not touching a PV leaf */
 		if (ent != clent)
 		{
 			/* check area */
-			if (!CM_AreasConnected(clientarea, ent->areanum))
+			if (!CM_AreasConnected(clientarea, hot_areanum[h]))
 			{
 				/* doors can legally straddle two areas,
 				   so we may need to check another one */
-				if (!ent->areanum2 ||
-					!CM_AreasConnected(clientarea, ent->areanum2))
+				if (!hot_areanum2[h] ||
+					!CM_AreasConnected(clientarea, hot_areanum2[h]))
 				{
 					continue; /* blocked by a door */
 				}
 			}
 
+			clusters = &hot_clusters[hot_firstcluster[h]];
+
 			/* beams just check one point for PHS */
-			if (ent->s.renderfx & RF_BEAM)
+			if (hot_flags[h] & HOT_BEAM)
 			{
-				l = ent->clusternums[0];
+				l = clusters[0];
 
 				if (!(clientphs[l >> 3] & (1 << (l & 7))))
 				{
@@ -589,10 +680,10 @@ SV_BuildClientFrame(client_t *client)
 			{
 				bitvector = fatpvs;
 
-				if (ent->num_clusters == -1)
+				if (hot_numclusters[h] == -1)
 				{
 					/* too many leafs for individual check, go by headnode */
-					if (!CM_HeadnodeVisible(ent->headnode, bitvector))
+					if (!CM_HeadnodeVisible(hot_headnode[h], bitvector))
 					{
 						continue;
 					}
@@ -602,9 +693,9 @@ SV_BuildClientFrame(client_t *client)
 				else
 				{
 					/* check individual leafs */
-					for (i = 0; i < ent->num_clusters; i++)
+					for (i = 0; i < hot_numclusters[h]; i++)
 					{
-						l = ent->clusternums[i];
+						l = clusters[i];
 
 						if (bitvector[l >> 3] & (1 << (l & 7)))
 						{
@@ -612,13 +703,13 @@ SV_BuildClientFrame(client_t *client)
 						}
 					}
 
-					if (i == ent->num_clusters)
+					if (i == hot_numclusters[h])
 					{
 						continue; /* not visible */
 					}
 				}
 
-				if (!ent->s.modelindex)
+				if (hot_flags[h] & HOT_NOMODEL)
 				{
 					/* don't send sounds if they 
 					   will be attenuated away */
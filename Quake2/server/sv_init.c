@@ -274,11 +274,14 @@ SV_SpawnServer(char *server, char *spawnpoint, server_state_t serverstate,
 	Com_SetServerState(sv.state);
 
 	/* load and spawn all other entities */
+	SV_ReplaySpawn(server, spawnpoint);
+	SV_ReplayEnterGame();
 	ge->SpawnEntities(sv.name, CM_EntityString(), spawnpoint);
 
 	/* run two frames to allow everything to settle */
 	ge->RunFrame();
 	ge->RunFrame();
+	SV_ReplayLeaveGame();
 
 	/* verify game didn't clobber important stuff */
 	if ((int)checksum !=
@@ -69,7 +69,11 @@ SV_DropClient(client_t *drop)
 	{
 		/* call the prog function for removing a client
 		   this will remove the body, among other things */
+		SV_ReplayRecordDisconnect(drop);
+		SV_ReplayEnterGame();
 		ge->ClientDisconnect(drop->edict);
+		SV_ReplayLeaveGame();
+		SV_InvalidateHotEntities();
 	}
 
 	if (drop->download)
@@ -350,7 +354,10 @@ SV_RunGameFrame(void)
 	/* don't run if paused */
 	if (!sv_paused->value || (maxclients->value > 1))
 	{
+		SV_ReplayEnterGame();
 		ge->RunFrame();
+		SV_ReplayLeaveGame();
+		SV_ReplayRecordFrame();
 
 		/* never get more than one tic behind */
 		if (sv.time < svs.realtime)
@@ -530,7 +537,10 @@ SV_UserinfoChanged(client_t *cl)
 	int i;
 
 	/* call prog code to allow overrides */
+	SV_ReplayRecordUserinfo(cl);
+	SV_ReplayEnterGame();
 	ge->ClientUserinfoChanged(cl->edict, cl->userinfo);
+	SV_ReplayLeaveGame();
 
 	/* name for C code */
 	Q_strlcpy(cl->name, Info_ValueForKey(cl->userinfo, "name"), sizeof(cl->name));
@@ -669,6 +679,9 @@ SV_FinalMessage(char *message, qboolean reconnect)
 void
 SV_Shutdown(char *finalmsg, qboolean reconnect)
 {
+	/* before the final message, it must not reach fake replay clients */
+	SV_ReplayStop();
+
 	if (svs.clients)
 	{
 		SV_FinalMessage(finalmsg, reconnect);
@@ -0,0 +1,801 @@
+/*
+ * Copyright (C) 1997-2001 Id Software, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+ * 02111-1307, USA.
+ *
+ * =======================================================================
+ *
+ * Deterministic replay of game frames. "replayrecord" logs the map,
+ * a PRNG seed, the relevant cvars and every call into the game module
+ * (connects, userinfo, client and server commands, usercmds, frames)
+ * together with a hash of the world state after each frame. "replay"
+ * feeds such a log back into a fresh game without networking or
+ * rendering, as fast as possible, and checks the hashes. Any change
+ * to the game or server code that alters a single frame shows up as
+ * a hash mismatch.
+ *
+ * While recording or replaying, randk() is redirected to a seeded
+ * stream for the duration of each game call. The client shares the
+ * PRNG in a listen server, so the KISS state itself can't be trusted.
+ *
+ * =======================================================================
+ */
+
+#include "header/server.h"
+
+#define REPLAY_MAGIC (('P' << 24) + ('R' << 16) + ('2' << 8) + 'Q')
+#define REPLAY_VERSION 1
+
+enum
+{
+	rpl_end,
+	rpl_connect,
+	rpl_begin,
+	rpl_userinfo,
+	rpl_command,
+	rpl_move,
+	rpl_disconnect,
+	rpl_frame,
+	rpl_servercommand
+};
+
+/* cvars read by the game that change its behavior */
+static char *replay_cvars[] = {
+	"deathmatch", "coop", "skill", "maxclients", "maxentities",
+	"dmflags", "fraglimit", "timelimit", "cheats", "sv_gravity",
+	"sv_maxvelocity", "sv_rollangle", "sv_rollspeed", "sv_airaccelerate",
+	"run_pitch", "run_roll", "bob_up", "bob_pitch", "bob_roll",
+	"g_select_empty"
+};
+
+static char replay_armed[MAX_OSPATH];
+static FILE *replay_file;
+static qboolean replay_recording;
+static qboolean replay_playing;
+static uint64_t replay_rand;
+
+static void
+SV_ReplayWrite(const void *data, int len)
+{
+	if (!replay_file)
+	{
+		return;
+	}
+
+	if (fwrite(data, len, 1, replay_file) != 1)
+	{
+		Com_Printf("Replay write failed, recording stopped.\n");
+		fclose(replay_file);
+		replay_file = NULL;
+		replay_recording = false;
+	}
+}
+
+static void
+SV_ReplayWriteString(const char *s)
+{
+	short len;
+
+	len = (short)strlen(s);
+	SV_ReplayWrite(&len, sizeof(len));
+	SV_ReplayWrite(s, len);
+}
+
+static qboolean
+SV_ReplayRead(void *data, int len)
+{
+	return fread(data, len, 1, replay_file) == 1;
+}
+
+static qboolean
+SV_ReplayReadString(char *s, int size)
+{
+	short len;
+
+	if (!SV_ReplayRead(&len, sizeof(len)) || (len < 0) || (len >= size))
+	{
+		return false;
+	}
+
+	if (len && !SV_ReplayRead(s, len))
+	{
+		return false;
+	}
+
+	s[len] = 0;
+	return true;
+}
+
+static void
+SV_ReplayEvent(int type, client_t *cl)
+{
+	byte header[2];
+
+	header[0] = type;
+	header[1] = cl ? (cl - svs.clients) : 0;
+	SV_ReplayWrite(header, sizeof(header));
+}
+
+/*
+ * FNV-1a over everything a client can see:
+ * all entity states and all player states.
+ */
+static unsigned
+SV_ReplayHashBlock(unsigned hash, void *data, int len)
+{
+	byte *b;
+	int i;
+
+	b = (byte *)data;
+
+	for (i = 0; i < len; i++)
+	{
+		hash = (hash ^ b[i]) * 16777619;
+	}
+
+	return hash;
+}
+
+static unsigned
+SV_ReplayHash(void)
+{
+	unsigned hash;
+	edict_t *ent;
+	pmove_state_t *pm;
+	int e;
+
+	hash = 2166136261u;
+
+	for (e = 0; e < ge->num_edicts; e++)
+	{
+		ent = EDICT_NUM(e);
+
+		hash = SV_ReplayHashBlock(hash, &ent->inuse, sizeof(ent->inuse));
+
+		if (!ent->inuse)
+		{
+			continue;
+		}
+
+		hash = SV_ReplayHashBlock(hash, &ent->s, sizeof(ent->s));
+
+		if (!ent->client)
+		{
+			continue;
+		}
+
+		/* pmove_state_t has padding, hash it field by field */
+		pm = &ent->client->ps.pmove;
+		hash = SV_ReplayHashBlock(hash, &pm->pm_type, sizeof(pm->pm_type));
+		hash = SV_ReplayHashBlock(hash, pm->origin, sizeof(pm->origin));
+		hash = SV_ReplayHashBlock(hash, pm->velocity, sizeof(pm->velocity));
+		hash = SV_ReplayHashBlock(hash, &pm->pm_flags, sizeof(pm->pm_flags));
+		hash = SV_ReplayHashBlock(hash, &pm->pm_time, sizeof(pm->pm_time));
+		hash = SV_ReplayHashBlock(hash, &pm->gravity, sizeof(pm->gravity));
+		hash = SV_ReplayHashBlock(hash, pm->delta_angles, sizeof(pm->delta_angles));
+
+		hash = SV_ReplayHashBlock(hash, (byte *)&ent->client->ps + sizeof(*pm),
+				sizeof(player_state_t) - sizeof(*pm));
+	}
+
+	return hash;
+}
+
+/*
+ * Brackets every call into the game module
+ */
+void
+SV_ReplayEnterGame(void)
+{
+	if (replay_recording || replay_playing)
+	{
+		randk_redirect(&replay_rand);
+	}
+}
+
+void
+SV_ReplayLeaveGame(void)
+{
+	randk_redirect(NULL);
+}
+
+/*
+ * Called by SV_SpawnServer() right before the
+ * entities are spawned. Starts an armed recording.
+ */
+void
+SV_ReplaySpawn(char *server, char *spawnpoint)
+{
+	char name[MAX_OSPATH];
+	int magic, version, i;
+	unsigned seed;
+	short count;
+
+	/* a recording covers exactly one level */
+	if (replay_recording)
+	{
+		SV_ReplayStop();
+	}
+
+	if (!replay_armed[0] || replay_playing)
+	{
+		return;
+	}
+
+	if (sv.loadgame || sv.attractloop)
+	{
+		Com_Printf("Replays must start with a new game, not recording.\n");
+		replay_armed[0] = 0;
+		return;
+	}
+
+	Com_sprintf(name, sizeof(name), "%s/demos/%s.rpl", FS_Gamedir(), replay_armed);
+	replay_armed[0] = 0;
+
+	FS_CreatePath(name);
+	replay_file = Q_fopen(name, "wb");
+
+	if (!replay_file)
+	{
+		Com_Printf("ERROR: couldn't open %s.\n", name);
+		return;
+	}
+
+	Com_Printf("recording replay to %s.\n", name);
+
+	replay_recording = true;
+
+	seed = (unsigned)randk() | 1;
+	replay_rand = seed;
+
+	magic = REPLAY_MAGIC;
+	version = REPLAY_VERSION;
+	SV_ReplayWrite(&magic, sizeof(magic));
+	SV_ReplayWrite(&version, sizeof(version));
+	SV_ReplayWrite(&seed, sizeof(seed));
+	SV_ReplayWriteString(server);
+	SV_ReplayWriteString(spawnpoint);
+
+	count = sizeof(replay_cvars) / sizeof(replay_cvars[0]);
+	SV_ReplayWrite(&count, sizeof(count));
+
+	for (i = 0; i < count; i++)
+	{
+		SV_ReplayWriteString(replay_cvars[i]);
+		SV_ReplayWriteString(Cvar_VariableString(replay_cvars[i]));
+	}
+}
+
+/*
+ * Ends playback, also when it was cut short by
+ * an error. The fake clients are released here,
+ * they must not get the final message.
+ */
+static void
+SV_ReplayStopPlayback(void)
+{
+	int i;
+
+	randk_redirect(NULL);
+
+	if (replay_file)
+	{
+		fclose(replay_file);
+		replay_file = NULL;
+	}
+
+	replay_playing = false;
+
+	if (svs.clients)
+	{
+		for (i = 0; i < maxclients->value; i++)
+		{
+			svs.clients[i].state = cs_free;
+		}
+	}
+}
+
+void
+SV_ReplayStop(void)
+{
+	if (replay_playing)
+	{
+		SV_ReplayStopPlayback();
+		return;
+	}
+
+	if (!replay_recording)
+	{
+		return;
+	}
+
+	SV_ReplayEvent(rpl_end, NULL);
+
+	if (replay_file)
+	{
+		fclose(replay_file);
+		replay_file = NULL;
+	}
+
+	replay_recording = false;
+	Com_Printf("Replay recording completed.\n");
+}
+
+void
+SV_ReplayRecordConnect(client_t *cl, char *userinfo)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_connect, cl);
+		SV_ReplayWriteString(userinfo);
+	}
+}
+
+void
+SV_ReplayRecordBegin(client_t *cl)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_begin, cl);
+	}
+}
+
+void
+SV_ReplayRecordUserinfo(client_t *cl)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_userinfo, cl);
+		SV_ReplayWriteString(cl->userinfo);
+	}
+}
+
+void
+SV_ReplayRecordCommand(client_t *cl, char *text)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_command, cl);
+		SV_ReplayWriteString(text);
+	}
+}
+
+/* an "sv" console command passed to the game */
+void
+SV_ReplayRecordServerCommand(void)
+{
+	char text[MAX_STRING_CHARS];
+
+	if (replay_recording)
+	{
+		Com_sprintf(text, sizeof(text), "%s %s", Cmd_Argv(0), Cmd_Args());
+		SV_ReplayEvent(rpl_servercommand, NULL);
+		SV_ReplayWriteString(text);
+	}
+}
+
+void
+SV_ReplayRecordMove(client_t *cl, usercmd_t *cmd)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_move, cl);
+		SV_ReplayWrite(cmd, sizeof(*cmd));
+	}
+}
+
+void
+SV_ReplayRecordDisconnect(client_t *cl)
+{
+	if (replay_recording)
+	{
+		SV_ReplayEvent(rpl_disconnect, cl);
+	}
+}
+
+void
+SV_ReplayRecordFrame(void)
+{
+	unsigned hash;
+
+	if (replay_recording)
+	{
+		hash = SV_ReplayHash();
+		SV_ReplayEvent(rpl_frame, NULL);
+		SV_ReplayWrite(&hash, sizeof(hash));
+	}
+}
+
+/*
+ * Arms a recording. It starts with the next new
+ * game, e.g. "replayrecord foo; map base1".
+ */
+void
+SV_ReplayRecord_f(void)
+{
+	if (Cmd_Argc() != 2)
+	{
+		Com_Printf("replayrecord <name>\n");
+		return;
+	}
+
+	if (replay_recording || replay_armed[0])
+	{
+		Com_Printf("Already recording.\n");
+		return;
+	}
+
+	if (svs.initialized)
+	{
+		Com_Printf("Replays must start with a new game, kill the server first.\n");
+		return;
+	}
+
+	if (strstr(Cmd_Argv(1), "..") ||
+		strstr(Cmd_Argv(1), "/") ||
+		strstr(Cmd_Argv(1), "\\"))
+	{
+		Com_Printf("Illegal filename.\n");
+		return;
+	}
+
+	Q_strlcpy(replay_armed, Cmd_Argv(1), sizeof(replay_armed));
+	Com_Printf("Replay recording starts with the next map.\n");
+}
+
+void
+SV_ReplayStop_f(void)
+{
+	if (replay_armed[0])
+	{
+		replay_armed[0] = 0;
+		Com_Printf("Replay recording canceled.\n");
+		return;
+	}
+
+	if (!replay_recording)
+	{
+		Com_Printf("Not recording a replay.\n");
+		return;
+	}
+
+	SV_ReplayStop();
+}
+
+/*
+ * Sets up a fake client slot. Nothing is ever
+ * transmitted, the buffers only catch what the
+ * game sends and are cleared every frame.
+ */
+static client_t *
+SV_ReplayClient(int clientnum)
+{
+	client_t *cl;
+	netadr_t adr;
+
+	if ((clientnum < 0) || (clientnum >= maxclients->value))
+	{
+		Com_Printf("Replay: bad client number %i.\n", clientnum);
+		return NULL;
+	}
+
+	cl = &svs.clients[clientnum];
+
+	if (cl->state == cs_free)
+	{
+		memset(&adr, 0, sizeof(adr));
+		Netchan_Setup(NS_SERVER, &cl->netchan, adr, 0);
+
+		SZ_Init(&cl->datagram, cl->datagram_buf, sizeof(cl->datagram_buf));
+		cl->datagram.allowoverflow = true;
+		cl->edict = EDICT_NUM(clientnum + 1);
+		cl->state = cs_connected;
+	}
+
+	return cl;
+}
+
+static void
+SV_ReplayClearClients(void)
+{
+	client_t *cl;
+	int i;
+
+	for (i = 0, cl = svs.clients; i < maxclients->value; i++, cl++)
+	{
+		SZ_Clear(&cl->netchan.message);
+		SZ_Clear(&cl->datagram);
+	}
+}
+
+/*
+ * Plays a recording back headless and reports
+ * the speed and any diverging frames.
+ */
+void
+SV_Replay_f(void)
+{
+	char name[MAX_OSPATH];
+	char map[MAX_QPATH], spawnpoint[MAX_QPATH];
+	char cvar[MAX_QPATH], value[MAX_QPATH];
+	char text[MAX_STRING_CHARS];
+	int magic, version, i;
+	int frames, mismatches, start, msec;
+	unsigned seed, hash, recorded;
+	short count;
+	byte header[2];
+	usercmd_t cmd;
+	client_t *cl;
+	qboolean verbose, truncated;
+
+	if ((Cmd_Argc() != 2) && (Cmd_Argc() != 3))
+	{
+		Com_Printf("replay <name> [verbose]\n");
+		return;
+	}
+
+	if (replay_recording || replay_armed[0])
+	{
+		Com_Printf("Can't replay while recording.\n");
+		return;
+	}
+
+	if (strstr(Cmd_Argv(1), "..") ||
+		strstr(Cmd_Argv(1), "/") ||
+		strstr(Cmd_Argv(1), "\\"))
+	{
+		Com_Printf("Illegal filename.\n");
+		return;
+	}
+
+	verbose = (Cmd_Argc() == 3) && !strcmp(Cmd_Argv(2), "verbose");
+
+	Com_sprintf(name, sizeof(name), "%s/demos/%s.rpl", FS_Gamedir(), Cmd_Argv(1));
+	replay_file = Q_fopen(name, "rb");
+
+	if (!replay_file)
+	{
+		Com_Printf("ERROR: couldn't open %s.\n", name);
+		return;
+	}
+
+	if (!SV_ReplayRead(&magic, sizeof(magic)) || (magic != REPLAY_MAGIC) ||
+		!SV_ReplayRead(&version, sizeof(version)) || (version != REPLAY_VERSION) ||
+		!SV_ReplayRead(&seed, sizeof(seed)) ||
+		!SV_ReplayReadString(map, sizeof(map)) ||
+		!SV_ReplayReadString(spawnpoint, sizeof(spawnpoint)) ||
+		!SV_ReplayRead(&count, sizeof(count)))
+	{
+		Com_Printf("%s is not a valid replay.\n", name);
+		fclose(replay_file);
+		replay_file = NULL;
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		if (!SV_ReplayReadString(cvar, sizeof(cvar)) ||
+			!SV_ReplayReadString(value, sizeof(value)))
+		{
+			Com_Printf("%s is not a valid replay.\n", name);
+			fclose(replay_file);
+			replay_file = NULL;
+			return;
+		}
+
+		Cvar_Set(cvar, value);
+	}
+
+	/* start a new game, exactly like the map command */
+	if (svs.initialized)
+	{
+		SV_Shutdown("Server quit\n", false);
+	}
+
+	SV_WipeSavegame("current");
+	SV_InitGame();
+
+	replay_playing = true;
+	replay_rand = seed;
+
+	SV_SpawnServer(map, spawnpoint, ss_game, false, false);
+
+	frames = 0;
+	mismatches = 0;
+	truncated = false;
+	start = Sys_Milliseconds();
+
+	while (!truncated)
+	{
+		if (!SV_ReplayRead(header, sizeof(header)))
+		{
+			truncated = true;
+			break;
+		}
+
+		if (header[0] == rpl_end)
+		{
+			break;
+		}
+
+		if (header[0] == rpl_frame)
+		{
+			if (!SV_ReplayRead(&recorded, sizeof(recorded)))
+			{
+				truncated = true;
+				break;
+			}
+
+			sv.framenum++;
+			sv.time = sv.framenum * 100;
+
+			SV_ReplayEnterGame();
+			ge->RunFrame();
+			SV_ReplayLeaveGame();
+
+			SV_ReplayClearClients();
+
+			hash = SV_ReplayHash();
+			frames++;
+
+			/* events only last for a single frame, like in SV_Frame() */
+			SV_PrepWorldFrame();
+
+			if (hash != recorded)
+			{
+				if (!mismatches)
+				{
+					Com_Printf("Replay diverged at frame %i.\n", frames);
+				}
+
+				mismatches++;
+			}
+
+			if (verbose)
+			{
+				Com_Printf("frame %5i: %08x%s\n", frames, hash,
+						hash != recorded ? " MISMATCH" : "");
+			}
+
+			continue;
+		}
+
+		if (header[0] == rpl_servercommand)
+		{
+			if (!SV_ReplayReadString(text, sizeof(text)))
+			{
+				truncated = true;
+				break;
+			}
+
+			Cmd_TokenizeString(text, false);
+
+			SV_ReplayEnterGame();
+			ge->ServerCommand();
+			SV_ReplayLeaveGame();
+			continue;
+		}
+
+		cl = SV_ReplayClient(header[1]);
+
+		if (!cl)
+		{
+			truncated = true;
+			break;
+		}
+
+		switch (header[0])
+		{
+			case rpl_connect:
+				if (!SV_ReplayReadString(text, sizeof(text)))
+				{
+					truncated = true;
+					break;
+				}
+
+				SV_ReplayEnterGame();
+
+				if (ge->ClientConnect(cl->edict, text))
+				{
+					Q_strlcpy(cl->userinfo, text, sizeof(cl->userinfo));
+				}
+				else
+				{
+					cl->state = cs_free;
+				}
+
+				SV_ReplayLeaveGame();
+				break;
+
+			case rpl_begin:
+				cl->state = cs_spawned;
+
+				SV_ReplayEnterGame();
+				ge->ClientBegin(cl->edict);
+				SV_ReplayLeaveGame();
+				break;
+
+			case rpl_userinfo:
+				if (!SV_ReplayReadString(cl->userinfo, sizeof(cl->userinfo)))
+				{
+					truncated = true;
+					break;
+				}
+
+				SV_ReplayEnterGame();
+				ge->ClientUserinfoChanged(cl->edict, cl->userinfo);
+				SV_ReplayLeaveGame();
+				break;
+
+			case rpl_command:
+				if (!SV_ReplayReadString(text, sizeof(text)))
+				{
+					truncated = true;
+					break;
+				}
+
+				Cmd_TokenizeString(text, false);
+				sv_client = cl;
+				sv_player = cl->edict;
+
+				SV_ReplayEnterGame();
+				ge->ClientCommand(cl->edict);
+				SV_ReplayLeaveGame();
+				break;
+
+			case rpl_move:
+				if (!SV_ReplayRead(&cmd, sizeof(cmd)))
+				{
+					truncated = true;
+					break;
+				}
+
+				SV_ReplayEnterGame();
+				ge->ClientThink(cl->edict, &cmd);
+				SV_ReplayLeaveGame();
+				break;
+
+			case rpl_disconnect:
+				SV_ReplayEnterGame();
+				ge->ClientDisconnect(cl->edict);
+				SV_ReplayLeaveGame();
+
+				cl->state = cs_free;
+				break;
+
+			default:
+				Com_Printf("Replay: unknown event %i.\n", header[0]);
+				truncated = true;
+				break;
+		}
+	}
+
+	if (truncated)
+	{
+		Com_Printf("Replay is truncated.\n");
+	}
+
+	msec = Sys_Milliseconds() - start;
+
+	Com_Printf("%i frames, %i msec, %.1f fps, %i mismatches\n", frames, msec,
+			msec ? frames * 1000.0f / msec : 0.0f, mismatches);
+
+	/* the fake clients have nobody to talk to */
+	SV_ReplayStopPlayback();
+
+	SV_Shutdown("Replay finished\n", false);
+}
@@ -559,6 +559,9 @@ SV_SendClientMessages(void)
 		}
 	}
 
+	/* the game ran since the last send */
+	SV_InvalidateHotEntities();
+
 	/* send a message to each connected client */
 	for (i = 0, c = svs.clients; i < maxclients->value; i++, c++)
 	{
@@ -238,7 +238,10 @@ SV_Begin_f(void)
 	sv_client->state = cs_spawned;
 
 	/* call the game begin function */
+	SV_ReplayRecordBegin(sv_client);
+	SV_ReplayEnterGame();
 	ge->ClientBegin(sv_player);
+	SV_ReplayLeaveGame();
 
 	Cbuf_InsertFromDefer();
 }
@@ -473,7 +476,10 @@ SV_ExecuteUserCommand(char *s)
 
 	if (!u->name && (sv.state == ss_game))
 	{
+		SV_ReplayRecordCommand(sv_client, s);
+		SV_ReplayEnterGame();
 		ge->ClientCommand(sv_player);
+		SV_ReplayLeaveGame();
 	}
 }
 
@@ -489,7 +495,10 @@ SV_ClientThink(client_t *cl, usercmd_t *cmd)
 		return;
 	}
 
+	SV_ReplayRecordMove(cl, cmd);
+	SV_ReplayEnterGame();
 	ge->ClientThink(cl->edict, cmd);
+	SV_ReplayLeaveGame();
 }
 
 /*